@@ -0,0 +1,72 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+#include "../lib/BPlusTree.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using RedBlackTree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+template <typename Tree>
+void Measure(const char* name, const std::vector<int32_t>& keys, const std::vector<int32_t>& queries) {
+    auto start = Clock::now();
+
+    Tree tree;
+    for (int32_t key : keys) {
+        tree.insert(key);
+    }
+    double build = Milliseconds(start);
+
+    start = Clock::now();
+    size_t hits = 0;
+    for (int32_t key : queries) {
+        hits += tree.contains(key);
+    }
+    double lookup = Milliseconds(start);
+
+    start = Clock::now();
+    int64_t sum = 0;
+    for (int32_t key : queries) {
+        auto it = tree.lower_bound(key);
+        sum += (it != tree.end()) ? *it : 0;
+    }
+    double lower_bound = Milliseconds(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        tree.erase(keys[i]);
+    }
+    double erase = Milliseconds(start);
+
+    std::cout << name << ": build " << build << " ms, contains " << lookup << " ms (" << hits << " hits), lower_bound "
+              << lower_bound << " ms (" << sum << "), erase half " << erase << " ms" << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    size_t lookups = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+
+    std::mt19937 generator(42);
+    std::vector<int32_t> keys(count);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator() % (count * 2));
+    }
+
+    std::vector<int32_t> queries(lookups);
+    for (int32_t& key : queries) {
+        key = static_cast<int32_t>(generator() % (count * 2));
+    }
+
+    std::cout << count << " int32_t keys in random order, " << BPlusTree<int32_t>::node_capacity()
+              << " keys per B+-tree node, vectorized node search: " << std::boolalpha
+              << BPlusTree<int32_t>::is_vectorized() << std::endl;
+    Measure<RedBlackTree>("red-black  ", keys, queries);
+    Measure<BPlusTree<int32_t>>("B+-tree    ", keys, queries);
+}
@@ -0,0 +1,61 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int64_t, std::less<int64_t>, std::allocator<int64_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+void Report(const char* name, size_t queries, size_t hits, double milliseconds) {
+    std::cout << name << ": " << milliseconds << " ms, " << queries / milliseconds / 1000 << " M lookups/s ("
+              << hits << " hits)" << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    size_t queries = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+
+    // Random insertion order scatters the nodes over the heap, as a long-lived tree would
+    std::mt19937_64 generator(42);
+    Tree tree;
+    for (size_t i = 0; i < count; ++i) {
+        tree.insert(static_cast<int64_t>(generator() % (count * 2)));
+    }
+
+    std::vector<int64_t> keys(queries);
+    for (int64_t& key : keys) {
+        key = static_cast<int64_t>(generator() % (count * 2));
+    }
+
+    std::cout << queries << " lookups in a red-black tree of " << count << " nodes" << std::endl;
+
+    auto start = Clock::now();
+    size_t hits = 0;
+    for (int64_t key : keys) {
+        hits += (tree.find(key) != tree.end());
+    }
+    Report("find loop     ", queries, hits, Milliseconds(start));
+
+    std::vector<Tree::InOrderIterator<false>> found;
+    found.reserve(queries);
+    start = Clock::now();
+    tree.find_batch(keys, std::back_inserter(found));
+    hits = 0;
+    for (auto& it : found) {
+        hits += (it != tree.end());
+    }
+    Report("find_batch    ", queries, hits, Milliseconds(start));
+
+    std::vector<bool> contained;
+    contained.reserve(queries);
+    start = Clock::now();
+    tree.contains_batch(keys, std::back_inserter(contained));
+    hits = std::count(contained.begin(), contained.end(), true);
+    Report("contains_batch", queries, hits, Milliseconds(start));
+}
@@ -0,0 +1,95 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/CompactBinarySearchTree.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+size_t requested_bytes = 0;
+
+// Counts what the pointer layout asks for; the heap adds its own per-allocation header on top of it
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        requested_bytes += count * sizeof(T);
+
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* ptr, size_t count) {
+        requested_bytes -= count * sizeof(T);
+        std::allocator<T>().deallocate(ptr, count);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const {
+        return true;
+    }
+};
+
+template <typename Tree>
+size_t MemoryUsage(const Tree& tree) {
+    if constexpr (requires { tree.memory_usage(); }) {
+        return tree.memory_usage();
+    } else {
+        return requested_bytes;
+    }
+}
+
+template <typename Tree>
+void Measure(const char* name, const std::vector<int32_t>& keys, const std::vector<int32_t>& queries) {
+    auto start = Clock::now();
+
+    Tree tree;
+    for (int32_t key : keys) {
+        tree.insert(key);
+    }
+
+    double build = Milliseconds(start);
+    double bytes = static_cast<double>(MemoryUsage(tree)) / keys.size();
+
+    start = Clock::now();
+    size_t hits = 0;
+    for (int32_t key : queries) {
+        hits += tree.contains(key);
+    }
+    double lookup = Milliseconds(start);
+
+    std::cout << name << ": " << bytes << " bytes per node, build "
+              << build << " ms, " << queries.size() << " lookups " << lookup << " ms (" << hits << " hits)"
+              << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    size_t lookups = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2'000'000;
+
+    std::mt19937 generator(42);
+    std::vector<int32_t> keys(count);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator() % (count * 2));
+    }
+
+    std::vector<int32_t> queries(lookups);
+    for (int32_t& key : queries) {
+        key = static_cast<int32_t>(generator() % (count * 2));
+    }
+
+    std::cout << count << " int32_t keys in random order, node size " << CompactBinarySearchTree<int32_t>::node_size()
+              << " bytes in the compact layout" << std::endl;
+    Measure<BinarySearchTree<int32_t, std::less<int32_t>, CountingAllocator<int32_t>>>("pointer nodes", keys, queries);
+    Measure<CompactBinarySearchTree<int32_t>>("index nodes  ", keys, queries);
+}
@@ -0,0 +1,48 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/SplayBalance.hpp"
+
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int32_t main(int32_t argc, char** argv) {
+    int32_t count = (argc > 1) ? static_cast<int32_t>(std::strtol(argv[1], nullptr, 10)) : 10'000'000;
+
+    // Ascending inserts into a splay tree link every key as the right child of the root and rotate it up,
+    // so the build is O(n) and leaves a left spine of depth n
+    BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, SplayBalance> tree;
+
+    auto start = Clock::now();
+    for (int32_t i = 0; i < count; ++i) {
+        tree.insert(i);
+    }
+    std::cout << "build chain of " << count << " nodes: " << Milliseconds(start) << " ms" << std::endl;
+
+    size_t depth = 0;
+    for (auto node = tree.begin().Get(); node != nullptr; node = node->parent) {
+        depth += 1;
+    }
+    std::cout << "depth: " << depth << std::endl;
+
+    start = Clock::now();
+    auto copy = tree;
+    std::cout << "Copy: " << Milliseconds(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    bool equal = (copy == tree);
+    std::cout << "IsEqual: " << Milliseconds(start) << " ms (" << (equal ? "equal" : "different") << ")" << std::endl;
+
+    start = Clock::now();
+    copy.erase(0);
+    copy.extract(1);
+    std::cout << "erase + extract at the bottom of the chain: " << Milliseconds(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    tree.clear();
+    std::cout << "Destroy: " << Milliseconds(start) << " ms" << std::endl;
+}
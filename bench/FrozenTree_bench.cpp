@@ -0,0 +1,56 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+#include "../lib/FrozenBinarySearchTree.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+    size_t lookups = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 4'000'000;
+
+    std::mt19937 generator(42);
+    Tree tree;
+    for (size_t i = 0; i < count; ++i) {
+        tree.insert(static_cast<int32_t>(generator() % (count * 4)));
+    }
+
+    std::vector<int32_t> queries(lookups);
+    for (int32_t& key : queries) {
+        key = static_cast<int32_t>(generator() % (count * 4));
+    }
+
+    auto start = Clock::now();
+    FrozenBinarySearchTree<int32_t> frozen = tree.freeze();
+    std::cout << "freeze of " << count << " keys: " << Milliseconds(start) << " ms" << std::endl;
+
+    start = Clock::now();
+    int64_t checksum = 0;
+    for (int32_t key : queries) {
+        auto node = tree.lower_bound_node(key);
+        checksum += (node != nullptr) ? node->value : -1;
+    }
+    std::cout << "red-black lower_bound_node: " << Milliseconds(start) << " ms (checksum " << checksum << ")"
+              << std::endl;
+
+    start = Clock::now();
+    checksum = 0;
+    for (int32_t key : queries) {
+        auto it = frozen.lower_bound(key);
+        checksum += (it != frozen.end()) ? *it : -1;
+    }
+    std::cout << "frozen lower_bound:         " << Milliseconds(start) << " ms (checksum " << checksum << ")"
+              << std::endl;
+
+    start = Clock::now();
+    Tree thawed = frozen.thaw<Tree>();
+    std::cout << "thaw: " << Milliseconds(start) << " ms, " << thawed.size() << " keys" << std::endl;
+}
@@ -0,0 +1,58 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int64_t, std::less<int64_t>, std::allocator<int64_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+// Timestamps that mostly grow, with a share of late events pushed back by up to a thousand positions
+std::vector<int64_t> NearlySorted(size_t count, uint32_t late_percent) {
+    std::vector<int64_t> keys(count);
+    std::mt19937 generator(42);
+
+    for (size_t i = 0; i < count; ++i) {
+        keys[i] = static_cast<int64_t>(i) * 10;
+        if (generator() % 100 < late_percent) {
+            keys[i] -= static_cast<int64_t>(generator() % 10'000);
+        }
+    }
+
+    return keys;
+}
+
+void Compare(size_t count, uint32_t late_percent) {
+    std::vector<int64_t> keys = NearlySorted(count, late_percent);
+
+    auto start = Clock::now();
+    Tree descent;
+    for (int64_t key : keys) {
+        descent.insert(key);
+    }
+    double root = Milliseconds(start);
+
+    start = Clock::now();
+    Tree hinted;
+    for (int64_t key : keys) {
+        hinted.insert(hinted.end(), key);
+    }
+    double end = Milliseconds(start);
+
+    std::cout << late_percent << "% late events: root descent " << root << " ms, end() hint " << end
+              << " ms" << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+
+    std::cout << "inserting " << count << " nearly sorted keys" << std::endl;
+    Compare(count, 0);
+    Compare(count, 1);
+    Compare(count, 10);
+}
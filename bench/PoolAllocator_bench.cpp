@@ -0,0 +1,72 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+#include "../lib/PoolAllocator.hpp"
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+size_t heap_allocations = 0;
+
+void* operator new(size_t size) {
+    heap_allocations += 1;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+template <typename Allocator>
+void RunChurn(const char* name, const std::vector<int32_t>& keys, size_t rounds) {
+    using Tree = BinarySearchTree<int32_t, std::less<int32_t>, Allocator, RedBlackBalance>;
+
+    size_t allocations_before = heap_allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    {
+        Tree tree;
+        for (int32_t key : keys) {
+            tree.insert(key);
+        }
+
+        for (size_t round = 0; round < rounds; ++round) {
+            for (size_t i = round % 2; i < keys.size(); i += 2) {
+                tree.erase(keys[i]);
+            }
+            for (size_t i = round % 2; i < keys.size(); i += 2) {
+                tree.insert(keys[i]);
+            }
+        }
+    }
+
+    auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+    std::cout << name << ": " << heap_allocations - allocations_before << " heap allocations, "
+              << elapsed.count() << " ms" << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+    size_t rounds = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 10;
+
+    std::vector<int32_t> keys(count);
+    std::mt19937 generator(42);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator());
+    }
+
+    std::cout << count << " keys, " << rounds << " rounds of erasing and reinserting half of them" << std::endl;
+
+    RunChurn<std::allocator<int32_t>>("std::allocator ", keys, rounds);
+    RunChurn<PoolAllocator<int32_t>>("PoolAllocator  ", keys, rounds);
+}
@@ -0,0 +1,94 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/PreOrderIterator.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+
+// The previous PreOrderIterator::operator++, which walked from the root to the maximum on every step.
+// It also stopped early after a left leaf whose parent has no right child, so it is reported with its visit count.
+template <typename Node>
+Node* WalkToMaxNext(Node* root, Node* ptr) {
+    Node* max = root;
+    while (max->right != nullptr) {
+        max = max->right;
+    }
+
+    if (max == ptr) {
+        return nullptr;
+    }
+
+    if (ptr->left != nullptr) {
+        return ptr->left;
+    }
+    if (ptr->right != nullptr) {
+        return ptr->right;
+    }
+
+    while (ptr->parent->right == ptr) {
+        ptr = ptr->parent;
+    }
+    while (ptr->parent == nullptr || ptr->parent->left == ptr) {
+        ptr = ptr->parent;
+        if (ptr->parent == nullptr || ptr->parent->right != nullptr) {
+            ptr = ptr->right;
+            break;
+        }
+    }
+
+    return ptr;
+}
+
+template <typename Tree>
+void Compare(const char* name, Tree& tree) {
+    auto root = tree.begin(pre).Get();
+
+    auto start = Clock::now();
+    size_t legacy_visited = 0;
+    for (auto node = root; node != nullptr; node = WalkToMaxNext(root, node)) {
+        legacy_visited += 1;
+    }
+    double legacy = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    size_t visited = 0;
+    for (auto it = tree.begin(pre); it != tree.end(pre); ++it) {
+        visited += 1;
+    }
+    double forward = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    size_t reverse_visited = 0;
+    for (auto it = tree.rbegin(pre); it != tree.rend(pre); ++it) {
+        reverse_visited += 1;
+    }
+    double backward = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << name << ": walk-to-max " << legacy << " ms (" << legacy_visited << " nodes), operator++ "
+              << forward << " ms (" << visited << " nodes), operator-- " << backward << " ms ("
+              << reverse_visited << " nodes)" << std::endl;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::vector<int32_t> keys(count);
+    std::mt19937 generator(42);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator());
+    }
+
+    BinarySearchTree<int32_t> random_tree;
+    for (int32_t key : keys) {
+        random_tree.insert(key);
+    }
+
+    std::sort(keys.begin(), keys.end());
+    BinarySearchTree<int32_t> balanced_tree(keys.begin(), keys.end());
+
+    std::cout << "pre-order traversal of " << count << " nodes" << std::endl;
+    Compare("random insertion order", random_tree);
+    Compare("balanced bulk build   ", balanced_tree);
+}
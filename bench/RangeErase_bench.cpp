@@ -0,0 +1,58 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+
+    std::mt19937 generator(42);
+    std::vector<int32_t> keys(count);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator() % (count * 4));
+    }
+
+    // Expires the lower half of the key range, first one key at a time and then as one range
+    int32_t expiry = static_cast<int32_t>(count * 2);
+    Tree tree(keys.begin(), keys.end());
+    auto start = Clock::now();
+    while (!tree.empty() && tree.front() < expiry) {
+        tree.erase(tree.front());
+    }
+    double one_by_one = Milliseconds(start);
+
+    tree = Tree(keys.begin(), keys.end());
+    start = Clock::now();
+    size_t expired = tree.erase_range(std::numeric_limits<int32_t>::min(), expiry);
+    double range = Milliseconds(start);
+
+    // Drops every odd key, by per-key erase and by one erase_if sweep
+    tree = Tree(keys.begin(), keys.end());
+    start = Clock::now();
+    for (int32_t key : keys) {
+        if (key % 2 != 0) {
+            tree.erase(key);
+        }
+    }
+    double per_key = Milliseconds(start);
+
+    tree = Tree(keys.begin(), keys.end());
+    start = Clock::now();
+    size_t dropped = tree.erase_if([](int32_t key) { return key % 2 != 0; });
+    double sweep = Milliseconds(start);
+
+    std::cout << count << " keys in a red-black tree: expire " << expired << " keys one by one " << one_by_one
+              << " ms, with erase_range " << range << " ms; drop " << dropped << " odd keys one by one " << per_key
+              << " ms, with erase_if " << sweep << " ms (" << tree.size() << " left)" << std::endl;
+}
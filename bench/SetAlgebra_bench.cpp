@@ -0,0 +1,68 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+Tree RandomTree(size_t count, std::mt19937& generator) {
+    Tree tree;
+    for (size_t i = 0; i < count; ++i) {
+        tree.insert(static_cast<int32_t>(generator() % (count * 4)));
+    }
+
+    return tree;
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+
+    std::mt19937 generator(42);
+    Tree lhs = RandomTree(count, generator);
+    Tree rhs = RandomTree(count, generator);
+
+    auto start = Clock::now();
+    Tree inserted = lhs;
+    for (auto it = rhs.cbegin(in); it != rhs.cend(in); ++it) {
+        inserted.insert(*it);
+    }
+    double insert = Milliseconds(start);
+
+    start = Clock::now();
+    Tree united = lhs.merge_union(rhs);
+    double merge_union = Milliseconds(start);
+
+    start = Clock::now();
+    Tree common = lhs.intersect(rhs);
+    double intersect = Milliseconds(start);
+
+    start = Clock::now();
+    Tree rest = lhs.difference(rhs);
+    double difference = Milliseconds(start);
+
+    std::cout << "two trees of " << count << " keys: copy and insert " << insert << " ms (" << inserted.size()
+              << " keys), merge_union " << merge_union << " ms (" << united.size() << " keys), intersect "
+              << intersect << " ms (" << common.size() << " keys), difference " << difference << " ms ("
+              << rest.size() << " keys)" << std::endl;
+
+    // Folds a shard a thousandth of the size into the large tree, copying and then reusing the nodes of both
+    Tree shard = RandomTree(count / 1000, generator);
+    start = Clock::now();
+    Tree copied = lhs.merge_union(shard);
+    double copy_shard = Milliseconds(start);
+
+    start = Clock::now();
+    size_t shard_size = shard.size();
+    Tree folded = Tree::merge_union(std::move(lhs), std::move(shard));
+    double fold_shard = Milliseconds(start);
+
+    std::cout << "shard of " << shard_size << " keys: merge_union " << copy_shard << " ms, consuming merge_union "
+              << fold_shard << " ms (" << folded.size() << " keys)" << std::endl;
+}
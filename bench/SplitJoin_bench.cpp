@@ -0,0 +1,49 @@
+#include "../lib/BinarySearchTree.hpp"
+#include "../lib/InOrderIterator.hpp"
+#include "../lib/RedBlackBalance.hpp"
+
+#include <chrono>
+#include <random>
+
+using Clock = std::chrono::steady_clock;
+using Tree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance, true>;
+
+double Milliseconds(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+int32_t main(int32_t argc, char** argv) {
+    size_t count = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+    size_t rounds = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 1000;
+
+    std::mt19937 generator(42);
+    Tree tree;
+    for (size_t i = 0; i < count; ++i) {
+        tree.insert(static_cast<int32_t>(generator() % (count * 4)));
+    }
+
+    // Copies every key into one of two new trees, which is what partitioning by key range costs without split
+    int32_t pivot = static_cast<int32_t>(count * 2);
+    auto start = Clock::now();
+    Tree lower;
+    Tree upper;
+    for (auto it = tree.cbegin(in); it != tree.cend(in); ++it) {
+        if (*it < pivot) {
+            lower.insert(*it);
+        } else {
+            upper.insert(*it);
+        }
+    }
+    double copy = Milliseconds(start);
+
+    start = Clock::now();
+    for (size_t i = 0; i < rounds; ++i) {
+        auto [left, right] = tree.split(static_cast<int32_t>(generator() % (count * 4)));
+        tree = Tree::join(std::move(left), std::move(right));
+    }
+    double split_join = Milliseconds(start);
+
+    std::cout << count << " keys in an order-statistic red-black tree: partition by copying " << copy << " ms ("
+              << lower.size() << " + " << upper.size() << " keys), split and join back "
+              << split_join * 1000.0 / rounds << " us per round (" << tree.size() << " keys)" << std::endl;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+const size_t kDefaultArenaChunkSize = 256 * 1024;
+
+// Monotonic bump allocator: memory is only given back all at once by Release(), which keeps the chunks for reuse.
+class Arena {
+ public:
+    explicit Arena(size_t chunk_size = kDefaultArenaChunkSize) :
+        chunk_size_(chunk_size), chunk_index_(0), current_(nullptr), end_(nullptr) {}
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        for (const Chunk& chunk : chunks_) {
+            ::operator delete(chunk.data);
+        }
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        while (true) {
+            if (current_ != nullptr) {
+                auto address = reinterpret_cast<uintptr_t>(current_);
+                size_t padding = (alignment - address % alignment) % alignment;
+
+                if (static_cast<size_t>(end_ - current_) >= padding + bytes) {
+                    std::byte* result = current_ + padding;
+                    current_ = result + bytes;
+
+                    return result;
+                }
+
+                chunk_index_ += 1;
+            }
+
+            if (chunk_index_ == chunks_.size() || chunks_[chunk_index_].size < bytes + alignment) {
+                size_t size = std::max(chunk_size_, bytes + alignment);
+                chunks_.insert(chunks_.begin() + chunk_index_,
+                               Chunk{static_cast<std::byte*>(::operator new(size)), size});
+            }
+
+            current_ = chunks_[chunk_index_].data;
+            end_ = current_ + chunks_[chunk_index_].size;
+        }
+    }
+
+    void Release() noexcept {
+        chunk_index_ = 0;
+        current_ = nullptr;
+        end_ = nullptr;
+    }
+
+    [[nodiscard]] size_t ChunkSize() const {
+        return chunk_size_;
+    }
+
+    [[nodiscard]] size_t ChunkCount() const {
+        return chunks_.size();
+    }
+
+    [[nodiscard]] size_t BytesUsed() const {
+        size_t bytes = 0;
+        for (size_t i = 0; i < chunk_index_ && i < chunks_.size(); ++i) {
+            bytes += chunks_[i].size;
+        }
+
+        if (current_ != nullptr) {
+            bytes += current_ - chunks_[chunk_index_].data;
+        }
+
+        return bytes;
+    }
+
+ private:
+    struct Chunk {
+        std::byte* data;
+        size_t size;
+    };
+
+    size_t chunk_size_;
+    size_t chunk_index_;
+    std::byte* current_;
+    std::byte* end_;
+    std::vector<Chunk> chunks_;
+};
+
+// Allocator over a shared Arena. deallocate is a no-op, so a container holding trivially destructible
+// values can drop all of its nodes at once with release().
+template <typename T>
+class ArenaAllocator {
+ public:
+    using value_type                             = T;
+    using is_monotonic                           = std::true_type;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    ArenaAllocator() : arena_(std::make_shared<Arena>()) {}
+    explicit ArenaAllocator(size_t chunk_size) : arena_(std::make_shared<Arena>(chunk_size)) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena_(other.arena_) {}
+
+    ArenaAllocator select_on_container_copy_construction() const {
+        return ArenaAllocator(arena_->ChunkSize());
+    }
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(arena_->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, size_t) noexcept {}
+
+    // Rewinds the arena unless another allocator still shares it
+    void release() noexcept {
+        if (arena_.use_count() == 1) {
+            arena_->Release();
+        }
+    }
+
+    [[nodiscard]] const Arena& arena() const {
+        return *arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const {
+        return arena_ == other.arena_;
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    template <typename U>
+    friend class ArenaAllocator;
+
+    std::shared_ptr<Arena> arena_;
+};
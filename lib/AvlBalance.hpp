@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// AVL balancing policy: subtree heights differ by at most one, so the height stays within 1.44 * log2(n + 2)
+struct AvlBalance {
+    struct NodeBase {
+        int32_t height = 1;
+    };
+
+    static constexpr bool kBalanced = true;
+
+    template <typename Tree, typename Node>
+    static void AfterInsert(Tree& tree, Node* node) {
+        Retrace(tree, node->parent);
+    }
+
+    template <typename Tree, typename Node>
+    static void AfterErase(Tree& tree, Node*, Node*, Node* parent) {
+        Retrace(tree, parent);
+    }
+
+    template <typename Tree, typename Node>
+    static void AfterAccess(Tree&, Node*) {}
+
+    template <typename Node>
+    static void AfterBuild(Node* node, size_t, size_t) {
+        Update(node);
+    }
+
+    // Hangs middle off the spine of the taller subtree where the heights differ by at most one, then retraces
+    // from there, so the cost is the height difference plus the retrace
+    template <typename Tree, typename Node>
+    static void Join(Tree& tree, Node* left, Node* middle, Node* right) {
+        if (Height(left) > Height(right) + 1) {
+            Node* parent = left;
+            while (Height(parent->right) > Height(right) + 1) {
+                parent = parent->right;
+            }
+
+            tree.LinkSubtrees(middle, parent->right, right, parent, false);
+        } else if (Height(right) > Height(left) + 1) {
+            Node* parent = right;
+            while (Height(parent->left) > Height(left) + 1) {
+                parent = parent->left;
+            }
+
+            tree.LinkSubtrees(middle, left, parent->left, parent, true);
+        } else {
+            tree.LinkSubtrees(middle, left, right, nullptr, false);
+        }
+
+        Update(middle);
+        Retrace(tree, middle->parent);
+    }
+
+ private:
+    template <typename Node>
+    static int32_t Height(const Node* node) {
+        return (node != nullptr) ? node->height : 0;
+    }
+
+    template <typename Node>
+    static void Update(Node* node) {
+        node->height = 1 + std::max(Height(node->left), Height(node->right));
+    }
+
+    template <typename Tree, typename Node>
+    static void Retrace(Tree& tree, Node* node) {
+        while (node != nullptr) {
+            Update(node);
+            int32_t balance = Height(node->left) - Height(node->right);
+
+            if (balance > 1) {
+                if (Height(node->left->left) < Height(node->left->right)) {
+                    Node* left = node->left;
+                    tree.RotateLeft(left);
+                    Update(left);
+                }
+
+                tree.RotateRight(node);
+                Update(node);
+                node = node->parent;
+                Update(node);
+            } else if (balance < -1) {
+                if (Height(node->right->right) < Height(node->right->left)) {
+                    Node* right = node->right;
+                    tree.RotateRight(right);
+                    Update(right);
+                }
+
+                tree.RotateLeft(node);
+                Update(node);
+                node = node->parent;
+                Update(node);
+            }
+
+            node = node->parent;
+        }
+    }
+};
@@ -0,0 +1,785 @@
+#pragma once
+
+#include <bit>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "BinarySearchTree.hpp"
+
+// B+-tree with one cache line of keys per node: 16 int32_t/float or 8 int64_t/double keys, 8 for anything larger.
+// Values live in the leaves, which are chained for in-order iteration; inner nodes only route the descent. For
+// arithmetic keys ordered by std::less a node is searched with SSE2/AVX2 compares and a movemask instead of one
+// branch per key. Insert and erase invalidate iterators, since they move keys between nodes.
+template <typename T, typename Compare = std::less<T>>
+class BPlusTree {
+ private:
+    static constexpr size_t kCacheLine = 64;
+    static constexpr size_t kNodeKeys = std::clamp<size_t>(kCacheLine / sizeof(T), 8, 16);
+    static constexpr size_t kMinKeys = kNodeKeys / 2;
+
+    // Comparing int64_t lanes needs SSE4.2 or AVX2, the other key types only SSE2
+    static constexpr bool kVectorized =
+#if defined(__SSE2__)
+        (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>) &&
+        (std::is_same_v<T, int32_t> || std::is_same_v<T, float> || std::is_same_v<T, double>
+#if defined(__AVX2__) || defined(__SSE4_2__)
+         || std::is_same_v<T, int64_t>
+#endif
+        );
+#else
+        false;
+#endif
+
+    struct InnerNode;
+
+    struct Node {
+        alignas(kCacheLine) T keys[kNodeKeys]{};
+        InnerNode* parent = nullptr;
+        uint16_t count = 0;
+        bool is_leaf;
+
+        explicit Node(bool leaf) : is_leaf(leaf) {}
+    };
+
+    struct LeafNode : Node {
+        LeafNode* prev = nullptr;
+        LeafNode* next = nullptr;
+
+        LeafNode() : Node(true) {}
+    };
+
+    // Holds count keys and count + 1 children; every key of children[i] is <= keys[i] <= every key of children[i + 1]
+    struct InnerNode : Node {
+        Node* children[kNodeKeys + 1]{};
+
+        InnerNode() : Node(false) {}
+    };
+
+    struct Position {
+        LeafNode* leaf;
+        size_t slot;
+    };
+
+ public:
+    template <bool IsConst>
+    class Iterator;
+
+    template <bool IsConst>
+    using InOrderIterator = Iterator<IsConst>;
+
+    BPlusTree() : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), compare_{} {}
+    explicit BPlusTree(const Compare& comp) : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), compare_(comp) {}
+    template <std::input_iterator InputIt>
+    BPlusTree(InputIt first, InputIt last, const Compare& comp = Compare())
+        : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), compare_(comp) {
+        assign(first, last);
+    }
+    BPlusTree(const BPlusTree& other);
+    BPlusTree(BPlusTree&& other) noexcept;
+    BPlusTree& operator=(BPlusTree other);
+    ~BPlusTree() { clear(); }
+
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+
+    Compare key_comp() const { return compare_; }
+
+    Iterator<false> begin(InOrderTag = InOrderTag()) { return Iterator<false>(head_, 0, this); }
+    Iterator<false> end(InOrderTag = InOrderTag()) { return Iterator<false>(nullptr, 0, this); }
+    Iterator<true> begin(InOrderTag = InOrderTag()) const { return Iterator<true>(head_, 0, this); }
+    Iterator<true> end(InOrderTag = InOrderTag()) const { return Iterator<true>(nullptr, 0, this); }
+    Iterator<true> cbegin(InOrderTag = InOrderTag()) const { return begin(); }
+    Iterator<true> cend(InOrderTag = InOrderTag()) const { return end(); }
+    std::reverse_iterator<Iterator<false>> rbegin(InOrderTag = InOrderTag()) { return std::reverse_iterator(end()); }
+    std::reverse_iterator<Iterator<false>> rend(InOrderTag = InOrderTag()) { return std::reverse_iterator(begin()); }
+    std::reverse_iterator<Iterator<true>> rbegin(InOrderTag = InOrderTag()) const { return std::reverse_iterator(end()); }
+    std::reverse_iterator<Iterator<true>> rend(InOrderTag = InOrderTag()) const { return std::reverse_iterator(begin()); }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t height() const;
+    static constexpr size_t node_capacity() { return kNodeKeys; }
+    static constexpr bool is_vectorized() { return kVectorized; }
+
+    const T& front() const { return head_->keys[0]; }
+    const T& back() const { return tail_->keys[tail_->count - 1]; }
+
+    std::pair<InOrderIterator<false>, bool> insert(const T& data) { return Insert(T(data)); }
+    std::pair<InOrderIterator<false>, bool> insert(T&& data) { return Insert(std::move(data)); }
+    template <typename... Args>
+    std::pair<InOrderIterator<false>, bool> emplace(Args&&... args) { return Insert(T(std::forward<Args>(args)...)); }
+    size_t erase(const T& data);
+    void clear();
+    void swap(BPlusTree& other) noexcept;
+
+    Iterator<false> find(const T& key) { return MakeIterator<false>(FindPosition(key)); }
+    Iterator<true> find(const T& key) const { return MakeIterator<true>(FindPosition(key)); }
+    bool contains(const T& key) const { return FindPosition(key).leaf != nullptr; }
+    size_t count(const T& key) const { return std::distance(lower_bound(key), upper_bound(key)); }
+    Iterator<false> lower_bound(const T& key) { return MakeIterator<false>(BoundPosition<false>(key)); }
+    Iterator<true> lower_bound(const T& key) const { return MakeIterator<true>(BoundPosition<false>(key)); }
+    Iterator<false> upper_bound(const T& key) { return MakeIterator<false>(BoundPosition<true>(key)); }
+    Iterator<true> upper_bound(const T& key) const { return MakeIterator<true>(BoundPosition<true>(key)); }
+
+    bool operator==(const BPlusTree& other) const;
+    bool operator!=(const BPlusTree& other) const { return !(*this == other); }
+
+ private:
+    template <bool IsConst>
+    Iterator<IsConst> MakeIterator(Position position) const;
+
+    template <bool Greater>
+    static uint32_t CompareMask(const T* keys, T key);
+    template <bool Inclusive>
+    size_t Rank(const Node* node, const T& key) const;
+    bool Less(const T& lhs, const T& rhs) const;
+
+    template <bool Inclusive>
+    Position BoundPosition(const T& key) const;
+    Position FindPosition(const T& key) const;
+
+    std::pair<InOrderIterator<false>, bool> Insert(T value);
+    void InsertIntoParent(Node* left, T separator, Node* right);
+    void Rebalance(Node* node);
+    void BorrowFromLeft(InnerNode* parent, size_t index);
+    void BorrowFromRight(InnerNode* parent, size_t index);
+    void Merge(InnerNode* parent, size_t index);
+    static size_t ChildIndex(const InnerNode* parent, const Node* child);
+
+    template <typename ForwardIt>
+    void Build(ForwardIt first, size_t count);
+    void Destroy(Node* node);
+
+    Node* root_;
+    LeafNode* head_;
+    LeafNode* tail_;
+    size_t size_;
+    Compare compare_;
+};
+
+// A position is a leaf and a slot in it, the end iterator has no leaf
+template <typename T, typename Compare>
+template <bool IsConst>
+class BPlusTree<T, Compare>::Iterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = T;
+    using pointer           = std::conditional_t<IsConst, const T*, T*>;
+    using reference         = std::conditional_t<IsConst, const T&, T&>;
+    using conditional_tree  = std::conditional_t<IsConst, const BPlusTree*, BPlusTree*>;
+
+    Iterator() : leaf_(nullptr), slot_(0), tree_(nullptr) {}
+    Iterator(LeafNode* leaf, size_t slot, conditional_tree tree) : leaf_(leaf), slot_(slot), tree_(tree) {}
+
+    operator Iterator<true>() const {
+        return Iterator<true>(leaf_, slot_, tree_);
+    }
+
+    Iterator& operator++() {
+        if (++slot_ == leaf_->count) {
+            leaf_ = leaf_->next;
+            slot_ = 0;
+        }
+
+        return *this;
+    }
+
+    Iterator operator++(int32_t) {
+        Iterator temp = *this;
+        ++(*this);
+
+        return temp;
+    }
+
+    Iterator& operator--() {
+        if (leaf_ == nullptr) {
+            leaf_ = tree_->tail_;
+            slot_ = leaf_->count;
+        } else if (slot_ == 0) {
+            leaf_ = leaf_->prev;
+            slot_ = leaf_->count;
+        }
+        --slot_;
+
+        return *this;
+    }
+
+    Iterator operator--(int32_t) {
+        Iterator temp = *this;
+        --(*this);
+
+        return temp;
+    }
+
+    reference operator*() const {
+        return leaf_->keys[slot_];
+    }
+
+    pointer operator->() const {
+        return &leaf_->keys[slot_];
+    }
+
+    bool operator==(const Iterator& other) const {
+        return leaf_ == other.leaf_ && slot_ == other.slot_ && tree_ == other.tree_;
+    }
+
+    bool operator!=(const Iterator& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    LeafNode* leaf_;
+    size_t slot_;
+    conditional_tree tree_;
+};
+
+template <typename T, typename Compare>
+BPlusTree<T, Compare>::BPlusTree(const BPlusTree& other)
+    : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), compare_(other.compare_) {
+    Build(other.begin(), other.size_);
+}
+
+template <typename T, typename Compare>
+BPlusTree<T, Compare>::BPlusTree(BPlusTree&& other) noexcept
+    : root_(nullptr), head_(nullptr), tail_(nullptr), size_(0), compare_(other.compare_) {
+    swap(other);
+}
+
+template <typename T, typename Compare>
+BPlusTree<T, Compare>& BPlusTree<T, Compare>::operator=(BPlusTree other) {
+    swap(other);
+
+    return *this;
+}
+
+template <typename T, typename Compare>
+template <std::input_iterator InputIt>
+void BPlusTree<T, Compare>::assign(InputIt first, InputIt last) {
+    clear();
+
+    std::vector<T> values(first, last);
+    auto less = [this](const T& lhs, const T& rhs) { return Less(lhs, rhs); };
+    if (!std::is_sorted(values.begin(), values.end(), less)) {
+        std::stable_sort(values.begin(), values.end(), less);
+    }
+
+    Build(std::make_move_iterator(values.begin()), values.size());
+}
+
+// Fills the leaves evenly from a sorted sequence, then groups each level under the next one. Splitting every level
+// into as few nodes as fit keeps all of them at least half full.
+template <typename T, typename Compare>
+template <typename ForwardIt>
+void BPlusTree<T, Compare>::Build(ForwardIt first, size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<std::pair<Node*, T>> level;
+    size_t leaves = (count + kNodeKeys - 1) / kNodeKeys;
+    LeafNode* prev = nullptr;
+
+    for (size_t i = 0; i < leaves; ++i) {
+        auto* leaf = new LeafNode();
+        leaf->count = static_cast<uint16_t>(count / leaves + (i < count % leaves));
+        for (size_t slot = 0; slot < leaf->count; ++slot, ++first) {
+            leaf->keys[slot] = *first;
+        }
+
+        leaf->prev = prev;
+        if (prev == nullptr) {
+            head_ = leaf;
+        } else {
+            prev->next = leaf;
+        }
+        prev = leaf;
+
+        level.emplace_back(leaf, leaf->keys[0]);
+    }
+    tail_ = prev;
+
+    while (level.size() > 1) {
+        std::vector<std::pair<Node*, T>> parents;
+        size_t nodes = (level.size() + kNodeKeys) / (kNodeKeys + 1);
+        auto child = level.begin();
+
+        for (size_t i = 0; i < nodes; ++i) {
+            auto* inner = new InnerNode();
+            size_t children = level.size() / nodes + (i < level.size() % nodes);
+            parents.emplace_back(inner, child->second);
+
+            for (size_t j = 0; j < children; ++j, ++child) {
+                if (j > 0) {
+                    inner->keys[j - 1] = std::move(child->second);
+                }
+                inner->children[j] = child->first;
+                child->first->parent = inner;
+            }
+            inner->count = static_cast<uint16_t>(children - 1);
+        }
+
+        level = std::move(parents);
+    }
+
+    root_ = level.front().first;
+    size_ = count;
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::Destroy(Node* node) {
+    if (node == nullptr) {
+        return;
+    }
+
+    if (node->is_leaf) {
+        delete static_cast<LeafNode*>(node);
+        return;
+    }
+
+    auto* inner = static_cast<InnerNode*>(node);
+    for (size_t i = 0; i <= inner->count; ++i) {
+        Destroy(inner->children[i]);
+    }
+    delete inner;
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::clear() {
+    Destroy(root_);
+    root_ = nullptr;
+    head_ = nullptr;
+    tail_ = nullptr;
+    size_ = 0;
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::swap(BPlusTree& other) noexcept {
+    std::swap(root_, other.root_);
+    std::swap(head_, other.head_);
+    std::swap(tail_, other.tail_);
+    std::swap(size_, other.size_);
+    std::swap(compare_, other.compare_);
+}
+
+template <typename T, typename Compare>
+size_t BPlusTree<T, Compare>::height() const {
+    size_t height = 0;
+    for (const Node* node = root_; node != nullptr; ++height) {
+        node = node->is_leaf ? nullptr : static_cast<const InnerNode*>(node)->children[0];
+    }
+
+    return height;
+}
+
+template <typename T, typename Compare>
+bool BPlusTree<T, Compare>::Less(const T& lhs, const T& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, T, T>) {
+        return compare_(lhs, rhs) < 0;
+    } else {
+        return compare_(lhs, rhs);
+    }
+}
+
+// Bit i is set when keys[i] is greater (or less) than the key. All slots are compared, the caller masks off the
+// ones past the node's count.
+template <typename T, typename Compare>
+template <bool Greater>
+uint32_t BPlusTree<T, Compare>::CompareMask(const T* keys, T key) {
+    uint32_t mask = 0;
+
+#if defined(__AVX2__)
+    for (size_t i = 0; i < kNodeKeys; i += 32 / sizeof(T)) {
+        uint32_t lanes = 0;
+        if constexpr (std::is_same_v<T, int32_t>) {
+            __m256i values = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+            __m256i needle = _mm256_set1_epi32(key);
+            __m256i result = Greater ? _mm256_cmpgt_epi32(values, needle) : _mm256_cmpgt_epi32(needle, values);
+            lanes = _mm256_movemask_ps(_mm256_castsi256_ps(result));
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            __m256i values = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+            __m256i needle = _mm256_set1_epi64x(key);
+            __m256i result = Greater ? _mm256_cmpgt_epi64(values, needle) : _mm256_cmpgt_epi64(needle, values);
+            lanes = _mm256_movemask_pd(_mm256_castsi256_pd(result));
+        } else if constexpr (std::is_same_v<T, float>) {
+            __m256 values = _mm256_load_ps(keys + i);
+            lanes = _mm256_movemask_ps(_mm256_cmp_ps(values, _mm256_set1_ps(key), Greater ? _CMP_GT_OQ : _CMP_LT_OQ));
+        } else if constexpr (std::is_same_v<T, double>) {
+            __m256d values = _mm256_load_pd(keys + i);
+            lanes = _mm256_movemask_pd(_mm256_cmp_pd(values, _mm256_set1_pd(key), Greater ? _CMP_GT_OQ : _CMP_LT_OQ));
+        }
+        mask |= lanes << i;
+    }
+#elif defined(__SSE2__)
+    for (size_t i = 0; i < kNodeKeys; i += 16 / sizeof(T)) {
+        uint32_t lanes = 0;
+        if constexpr (std::is_same_v<T, int32_t>) {
+            __m128i values = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+            __m128i needle = _mm_set1_epi32(key);
+            __m128i result = Greater ? _mm_cmpgt_epi32(values, needle) : _mm_cmpgt_epi32(needle, values);
+            lanes = _mm_movemask_ps(_mm_castsi128_ps(result));
+#if defined(__SSE4_2__)
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            __m128i values = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+            __m128i needle = _mm_set1_epi64x(key);
+            __m128i result = Greater ? _mm_cmpgt_epi64(values, needle) : _mm_cmpgt_epi64(needle, values);
+            lanes = _mm_movemask_pd(_mm_castsi128_pd(result));
+#endif
+        } else if constexpr (std::is_same_v<T, float>) {
+            __m128 values = _mm_load_ps(keys + i);
+            __m128 needle = _mm_set1_ps(key);
+            lanes = _mm_movemask_ps(Greater ? _mm_cmpgt_ps(values, needle) : _mm_cmplt_ps(values, needle));
+        } else if constexpr (std::is_same_v<T, double>) {
+            __m128d values = _mm_load_pd(keys + i);
+            __m128d needle = _mm_set1_pd(key);
+            lanes = _mm_movemask_pd(Greater ? _mm_cmpgt_pd(values, needle) : _mm_cmplt_pd(values, needle));
+        }
+        mask |= lanes << i;
+    }
+#else
+    static_cast<void>(keys);
+    static_cast<void>(key);
+#endif
+
+    return mask;
+}
+
+// Number of keys in the node that are less than the key, or not greater than it when Inclusive
+template <typename T, typename Compare>
+template <bool Inclusive>
+size_t BPlusTree<T, Compare>::Rank(const Node* node, const T& key) const {
+    if constexpr (kVectorized) {
+        uint32_t valid = (uint32_t{1} << node->count) - 1;
+        if constexpr (Inclusive) {
+            return node->count - std::popcount(CompareMask<true>(node->keys, key) & valid);
+        } else {
+            return std::popcount(CompareMask<false>(node->keys, key) & valid);
+        }
+    } else {
+        auto less = [this](const T& lhs, const T& rhs) { return Less(lhs, rhs); };
+        if constexpr (Inclusive) {
+            return std::upper_bound(node->keys, node->keys + node->count, key, less) - node->keys;
+        } else {
+            return std::lower_bound(node->keys, node->keys + node->count, key, less) - node->keys;
+        }
+    }
+}
+
+// A bound past the last key of its leaf is the first key of the next leaf, since separators bound whole subtrees
+template <typename T, typename Compare>
+template <bool Inclusive>
+typename BPlusTree<T, Compare>::Position BPlusTree<T, Compare>::BoundPosition(const T& key) const {
+    if (root_ == nullptr) {
+        return Position{nullptr, 0};
+    }
+
+    Node* node = root_;
+    while (!node->is_leaf) {
+        node = static_cast<InnerNode*>(node)->children[Rank<Inclusive>(node, key)];
+    }
+
+    auto* leaf = static_cast<LeafNode*>(node);
+    size_t slot = Rank<Inclusive>(leaf, key);
+    if (slot == leaf->count) {
+        return Position{leaf->next, 0};
+    }
+
+    return Position{leaf, slot};
+}
+
+template <typename T, typename Compare>
+typename BPlusTree<T, Compare>::Position BPlusTree<T, Compare>::FindPosition(const T& key) const {
+    Position position = BoundPosition<false>(key);
+    if (position.leaf == nullptr || Less(key, position.leaf->keys[position.slot])) {
+        return Position{nullptr, 0};
+    }
+
+    return position;
+}
+
+template <typename T, typename Compare>
+template <bool IsConst>
+typename BPlusTree<T, Compare>::template Iterator<IsConst> BPlusTree<T, Compare>::MakeIterator(Position position) const {
+    return Iterator<IsConst>(position.leaf, position.slot, const_cast<BPlusTree*>(this));
+}
+
+template <typename T, typename Compare>
+size_t BPlusTree<T, Compare>::ChildIndex(const InnerNode* parent, const Node* child) {
+    size_t index = 0;
+    while (parent->children[index] != child) {
+        ++index;
+    }
+
+    return index;
+}
+
+// Equal keys go after the ones already stored, like in BinarySearchTree
+template <typename T, typename Compare>
+std::pair<typename BPlusTree<T, Compare>::template InOrderIterator<false>, bool> BPlusTree<T, Compare>::Insert(T value) {
+    if (root_ == nullptr) {
+        auto* leaf = new LeafNode();
+        root_ = leaf;
+        head_ = leaf;
+        tail_ = leaf;
+    }
+
+    Node* node = root_;
+    while (!node->is_leaf) {
+        node = static_cast<InnerNode*>(node)->children[Rank<true>(node, value)];
+    }
+
+    auto* leaf = static_cast<LeafNode*>(node);
+    size_t slot = Rank<true>(leaf, value);
+    size_ += 1;
+
+    if (leaf->count < kNodeKeys) {
+        std::move_backward(leaf->keys + slot, leaf->keys + leaf->count, leaf->keys + leaf->count + 1);
+        leaf->keys[slot] = std::move(value);
+        leaf->count += 1;
+
+        return std::make_pair(Iterator<false>(leaf, slot, this), true);
+    }
+
+    std::array<T, kNodeKeys + 1> keys;
+    std::move(leaf->keys, leaf->keys + slot, keys.begin());
+    keys[slot] = std::move(value);
+    std::move(leaf->keys + slot, leaf->keys + kNodeKeys, keys.begin() + slot + 1);
+
+    auto* right = new LeafNode();
+    size_t left_count = (kNodeKeys + 1) / 2;
+    std::move(keys.begin(), keys.begin() + left_count, leaf->keys);
+    std::move(keys.begin() + left_count, keys.end(), right->keys);
+    leaf->count = static_cast<uint16_t>(left_count);
+    right->count = static_cast<uint16_t>(kNodeKeys + 1 - left_count);
+
+    right->prev = leaf;
+    right->next = leaf->next;
+    if (leaf->next == nullptr) {
+        tail_ = right;
+    } else {
+        leaf->next->prev = right;
+    }
+    leaf->next = right;
+
+    InsertIntoParent(leaf, right->keys[0], right);
+
+    if (slot < left_count) {
+        return std::make_pair(Iterator<false>(leaf, slot, this), true);
+    }
+
+    return std::make_pair(Iterator<false>(right, slot - left_count, this), true);
+}
+
+// Adds the separator and the new right sibling next to the left node, splitting full ancestors up to the root
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::InsertIntoParent(Node* left, T separator, Node* right) {
+    InnerNode* parent = left->parent;
+    if (parent == nullptr) {
+        auto* root = new InnerNode();
+        root->keys[0] = std::move(separator);
+        root->children[0] = left;
+        root->children[1] = right;
+        root->count = 1;
+        left->parent = root;
+        right->parent = root;
+        root_ = root;
+
+        return;
+    }
+
+    size_t index = ChildIndex(parent, left);
+    if (parent->count < kNodeKeys) {
+        std::move_backward(parent->keys + index, parent->keys + parent->count, parent->keys + parent->count + 1);
+        std::move_backward(parent->children + index + 1, parent->children + parent->count + 1,
+                           parent->children + parent->count + 2);
+        parent->keys[index] = std::move(separator);
+        parent->children[index + 1] = right;
+        parent->count += 1;
+        right->parent = parent;
+
+        return;
+    }
+
+    std::array<T, kNodeKeys + 1> keys;
+    std::array<Node*, kNodeKeys + 2> children;
+    std::move(parent->keys, parent->keys + index, keys.begin());
+    keys[index] = std::move(separator);
+    std::move(parent->keys + index, parent->keys + kNodeKeys, keys.begin() + index + 1);
+    std::copy(parent->children, parent->children + index + 1, children.begin());
+    children[index + 1] = right;
+    std::copy(parent->children + index + 1, parent->children + kNodeKeys + 1, children.begin() + index + 2);
+
+    auto* sibling = new InnerNode();
+    size_t left_count = (kNodeKeys + 1) / 2;
+    size_t right_count = kNodeKeys - left_count;
+
+    std::move(keys.begin(), keys.begin() + left_count, parent->keys);
+    std::copy(children.begin(), children.begin() + left_count + 1, parent->children);
+    std::move(keys.begin() + left_count + 1, keys.end(), sibling->keys);
+    std::copy(children.begin() + left_count + 1, children.end(), sibling->children);
+    parent->count = static_cast<uint16_t>(left_count);
+    sibling->count = static_cast<uint16_t>(right_count);
+
+    for (size_t i = 0; i <= left_count; ++i) {
+        parent->children[i]->parent = parent;
+    }
+    for (size_t i = 0; i <= right_count; ++i) {
+        sibling->children[i]->parent = sibling;
+    }
+
+    InsertIntoParent(parent, std::move(keys[left_count]), sibling);
+}
+
+// Removes one of the equal keys; a leaf left less than half full borrows from a sibling or merges with it
+template <typename T, typename Compare>
+size_t BPlusTree<T, Compare>::erase(const T& data) {
+    Position position = FindPosition(data);
+    if (position.leaf == nullptr) {
+        return 0;
+    }
+
+    LeafNode* leaf = position.leaf;
+    std::move(leaf->keys + position.slot + 1, leaf->keys + leaf->count, leaf->keys + position.slot);
+    leaf->count -= 1;
+    size_ -= 1;
+
+    if (leaf == root_) {
+        if (leaf->count == 0) {
+            clear();
+        }
+    } else if (leaf->count < kMinKeys) {
+        Rebalance(leaf);
+    }
+
+    return 1;
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::Rebalance(Node* node) {
+    InnerNode* parent = node->parent;
+    size_t index = ChildIndex(parent, node);
+
+    if (index > 0 && parent->children[index - 1]->count > kMinKeys) {
+        BorrowFromLeft(parent, index);
+        return;
+    }
+    if (index < parent->count && parent->children[index + 1]->count > kMinKeys) {
+        BorrowFromRight(parent, index);
+        return;
+    }
+
+    Merge(parent, (index > 0) ? index - 1 : index);
+
+    if (parent == root_) {
+        if (parent->count == 0) {
+            root_ = parent->children[0];
+            root_->parent = nullptr;
+            delete parent;
+        }
+    } else if (parent->count < kMinKeys) {
+        Rebalance(parent);
+    }
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::BorrowFromLeft(InnerNode* parent, size_t index) {
+    Node* node = parent->children[index];
+    Node* left = parent->children[index - 1];
+
+    std::move_backward(node->keys, node->keys + node->count, node->keys + node->count + 1);
+    if (node->is_leaf) {
+        node->keys[0] = std::move(left->keys[left->count - 1]);
+        parent->keys[index - 1] = node->keys[0];
+    } else {
+        auto* inner = static_cast<InnerNode*>(node);
+        auto* left_inner = static_cast<InnerNode*>(left);
+
+        std::move_backward(inner->children, inner->children + inner->count + 1, inner->children + inner->count + 2);
+        inner->keys[0] = std::move(parent->keys[index - 1]);
+        inner->children[0] = left_inner->children[left->count];
+        inner->children[0]->parent = inner;
+        parent->keys[index - 1] = std::move(left->keys[left->count - 1]);
+    }
+
+    node->count += 1;
+    left->count -= 1;
+}
+
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::BorrowFromRight(InnerNode* parent, size_t index) {
+    Node* node = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    if (node->is_leaf) {
+        node->keys[node->count] = std::move(right->keys[0]);
+        std::move(right->keys + 1, right->keys + right->count, right->keys);
+        parent->keys[index] = right->keys[0];
+    } else {
+        auto* inner = static_cast<InnerNode*>(node);
+        auto* right_inner = static_cast<InnerNode*>(right);
+
+        inner->keys[inner->count] = std::move(parent->keys[index]);
+        inner->children[inner->count + 1] = right_inner->children[0];
+        inner->children[inner->count + 1]->parent = inner;
+        parent->keys[index] = std::move(right->keys[0]);
+        std::move(right->keys + 1, right->keys + right->count, right->keys);
+        std::move(right_inner->children + 1, right_inner->children + right->count + 1, right_inner->children);
+    }
+
+    node->count += 1;
+    right->count -= 1;
+}
+
+// Appends children[index + 1] to children[index] and drops the separator between them from the parent
+template <typename T, typename Compare>
+void BPlusTree<T, Compare>::Merge(InnerNode* parent, size_t index) {
+    Node* left = parent->children[index];
+    Node* right = parent->children[index + 1];
+
+    if (left->is_leaf) {
+        auto* left_leaf = static_cast<LeafNode*>(left);
+        auto* right_leaf = static_cast<LeafNode*>(right);
+
+        std::move(right->keys, right->keys + right->count, left->keys + left->count);
+        left->count += right->count;
+
+        left_leaf->next = right_leaf->next;
+        if (right_leaf->next == nullptr) {
+            tail_ = left_leaf;
+        } else {
+            right_leaf->next->prev = left_leaf;
+        }
+        delete right_leaf;
+    } else {
+        auto* left_inner = static_cast<InnerNode*>(left);
+        auto* right_inner = static_cast<InnerNode*>(right);
+
+        left->keys[left->count] = std::move(parent->keys[index]);
+        std::move(right->keys, right->keys + right->count, left->keys + left->count + 1);
+        for (size_t i = 0; i <= right->count; ++i) {
+            left_inner->children[left->count + 1 + i] = right_inner->children[i];
+            right_inner->children[i]->parent = left_inner;
+        }
+        left->count += right->count + 1;
+        delete right_inner;
+    }
+
+    std::move(parent->keys + index + 1, parent->keys + parent->count, parent->keys + index);
+    std::move(parent->children + index + 2, parent->children + parent->count + 1, parent->children + index + 1);
+    parent->count -= 1;
+}
+
+template <typename T, typename Compare>
+bool BPlusTree<T, Compare>::operator==(const BPlusTree& other) const {
+    return size_ == other.size_ && std::equal(begin(), end(), other.begin());
+}
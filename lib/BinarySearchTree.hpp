@@ -4,18 +4,64 @@
 #include <cstdlib>
 #include <iostream>
 #include <iterator>
+#include <bit>
+#include <span>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <optional>
+#include <algorithm>
 #include <functional>
+#include <type_traits>
+#include <memory_resource>
+
+#include "NoBalance.hpp"
 
 const uint16_t kOneNode = 1;
+const size_t kBatchWidth = 16;
+const size_t kJoinRatio = 16;
 
 struct InOrderTag {} in;
 struct PreOrderTag {} pre;
 struct PostOrderTag {} post;
 
-template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>>
+inline void Prefetch(const void* address) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address);
+#else
+    static_cast<void>(address);
+#endif
+}
+
+// Comparators that declare is_transparent can compare stored values with other key types directly
+template <typename Compare>
+concept TransparentCompare = requires { typename Compare::is_transparent; };
+
+// Comparators may return an ordering instead of bool, which answers less, equal and greater with a single call
+template <typename Compare, typename Lhs, typename Rhs>
+concept ThreeWayCompare = requires(const Compare& compare, const Lhs& lhs, const Rhs& rhs) {
+    { compare(lhs, rhs) } -> std::convertible_to<std::weak_ordering>;
+};
+
+template <typename T, typename Compare>
+class FrozenBinarySearchTree;
+
+template <typename T, typename Compare = std::less<T>, typename Allocator = std::allocator<T>,
+          typename BalancePolicy = NoBalance, bool IsOrderStatistic = false>
 class BinarySearchTree {
  private:
-    struct Node {
+    friend BalancePolicy;
+
+    struct SubtreeSizeBase {
+        size_t subtree_size = 1;
+    };
+
+    struct NoSubtreeSizeBase {};
+
+    struct Node : BalancePolicy::NodeBase, std::conditional_t<IsOrderStatistic, SubtreeSizeBase, NoSubtreeSizeBase> {
         T value;
         Node* left;
         Node* right;
@@ -27,6 +73,9 @@ class BinarySearchTree {
             value(value), parent(parent) {}
         Node(const T& value, Node* left, Node* right, Node* parent) :
             value(value), left(left), right(right), parent(parent) {}
+        template <typename... Args>
+        explicit Node(std::in_place_t, Args&&... args) :
+            value(std::forward<Args>(args)...), left(nullptr), right(nullptr), parent(nullptr) {}
     };
 
  public:
@@ -41,24 +90,109 @@ class BinarySearchTree {
 
     using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
 
-    BinarySearchTree() : root_(nullptr), allocator_{}, compare_{} {}
+    // Move assignment only falls back to copying values when the allocators may differ and do not propagate
+    static constexpr bool kNothrowMoveAssign =
+        (std::allocator_traits<NodeAllocator>::propagate_on_container_move_assignment::value ||
+         std::allocator_traits<NodeAllocator>::is_always_equal::value) &&
+        std::is_nothrow_copy_assignable_v<Compare>;
+
+    // Owns a node taken out of a tree, so it can be moved into another tree without copying the value
+    class NodeHandle {
+     public:
+        using value_type     = T;
+        using allocator_type = Allocator;
+
+        constexpr NodeHandle() noexcept : node_(nullptr) {}
+        NodeHandle(NodeHandle&& other) noexcept :
+            node_(std::exchange(other.node_, nullptr)), allocator_(std::move(other.allocator_)) {
+            other.allocator_.reset();
+        }
+        NodeHandle& operator=(NodeHandle&& other) noexcept {
+            if (this != &other) {
+                Reset();
+                node_ = std::exchange(other.node_, nullptr);
+                allocator_ = std::move(other.allocator_);
+                other.allocator_.reset();
+            }
+
+            return *this;
+        }
+        ~NodeHandle() { Reset(); }
+
+        [[nodiscard]] bool empty() const noexcept { return node_ == nullptr; }
+        explicit operator bool() const noexcept { return node_ != nullptr; }
+        T& value() const { return node_->value; }
+        allocator_type get_allocator() const { return *allocator_; }
+
+        void swap(NodeHandle& other) noexcept {
+            std::swap(node_, other.node_);
+            std::swap(allocator_, other.allocator_);
+        }
+
+     private:
+        friend class BinarySearchTree;
+
+        NodeHandle(Node* node, const NodeAllocator& allocator) : node_(node), allocator_(allocator) {}
+
+        Node* Release() {
+            allocator_.reset();
+
+            return std::exchange(node_, nullptr);
+        }
+
+        void Reset() {
+            if (node_ != nullptr) {
+                std::allocator_traits<NodeAllocator>::destroy(*allocator_, node_);
+                std::allocator_traits<NodeAllocator>::deallocate(*allocator_, node_, kOneNode);
+                node_ = nullptr;
+            }
+            allocator_.reset();
+        }
+
+        Node* node_;
+        std::optional<NodeAllocator> allocator_;
+    };
+
+    using node_type = NodeHandle;
+
+    BinarySearchTree() : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_{}, allocator_{} {}
     BinarySearchTree(const BinarySearchTree& binary_search_tree);
+    BinarySearchTree(BinarySearchTree&& binary_search_tree) noexcept;
     ~BinarySearchTree();
     BinarySearchTree& operator=(const BinarySearchTree& binary_search_tree);
-    explicit BinarySearchTree(const Allocator& alloc) noexcept : allocator_(alloc), root_(nullptr) {}
+    BinarySearchTree& operator=(BinarySearchTree&& binary_search_tree) noexcept(kNothrowMoveAssign);
+    explicit BinarySearchTree(const Allocator& alloc) noexcept
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_{}, allocator_(alloc) {}
     explicit BinarySearchTree(const Compare& comp, const Allocator& alloc = Allocator())
-        : compare_(comp), allocator_(alloc), root_(nullptr) {}
-    BinarySearchTree(const BinarySearchTree& other, const Allocator& alloc) : allocator_(alloc), root_(nullptr) {
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_(comp), allocator_(alloc) {}
+    BinarySearchTree(const BinarySearchTree& other, const Allocator& alloc)
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_(other.compare_), allocator_(alloc) {
         root_ = Copy(other.root_);
+        size_ = other.size_;
+        UpdateBoundaries();
+    }
+    template <std::input_iterator InputIt>
+    BinarySearchTree(InputIt first, InputIt last, const Compare& comp = Compare(), const Allocator& alloc = Allocator())
+        : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_(comp), allocator_(alloc) {
+        assign(first, last);
     }
 
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+
     class value_compare {
      public:
         bool operator()(const T& lhs, const T& rhs) const {
-            return comp(lhs, rhs);
+            if constexpr (ThreeWayCompare<Compare, T, T>) {
+                return comp(lhs, rhs) < 0;
+            } else {
+                return comp(lhs, rhs);
+            }
         }
 
      protected:
+        friend class BinarySearchTree;
+
         Compare comp;
 
         explicit value_compare(Compare c) : comp(c) {}
@@ -68,7 +202,7 @@ class BinarySearchTree {
     Compare key_comp() const { return compare_; }
     Allocator get_allocator() const noexcept { return allocator_; }
 
-    void Destroy(Node* node);
+    size_t Destroy(Node* node);
     Node* Copy(const Node* node);
     bool IsEqual(Node* first, Node* second);
 
@@ -145,15 +279,56 @@ class BinarySearchTree {
     PreOrderIterator<false> find(const T& data, PreOrderTag);
     PostOrderIterator<false> find(const T& data, PostOrderTag);
 
-    T extract(const T& data);
-    void extract(const T& data, Node* &root, T& node);
+    node_type extract(const T& data);
+    node_type extract(InOrderIterator<false> position);
 
     std::pair<InOrderIterator<false>, bool> insert(const T& data) { return insert(data, InOrderTag{}); };
     std::pair<InOrderIterator<false>, bool> insert(const T& data, InOrderTag);
     std::pair<PreOrderIterator<false>, bool> insert(const T& data, PreOrderTag);
     std::pair<PostOrderIterator<false>, bool> insert(const T& data, PostOrderTag);
-    void erase(const T& data);
-    void erase(const T& data, Node* &root);
+    std::pair<InOrderIterator<false>, bool> insert(T&& data);
+    InOrderIterator<false> insert(InOrderIterator<false> hint, const T& data);
+    InOrderIterator<false> insert(InOrderIterator<false> hint, T&& data);
+    InOrderIterator<false> insert(node_type&& node);
+    template <typename... Args>
+    std::pair<InOrderIterator<false>, bool> emplace(Args&&... args);
+    template <typename... Args>
+    InOrderIterator<false> emplace_hint(InOrderIterator<false> hint, Args&&... args);
+    template <typename... Args>
+    std::pair<InOrderIterator<false>, bool> emplace_unique(Args&&... args);
+    std::pair<InOrderIterator<false>, bool> insert_unique(const T& data) { return emplace_unique(data); }
+    std::pair<InOrderIterator<false>, bool> insert_unique(T&& data) { return emplace_unique(std::move(data)); }
+    void merge(BinarySearchTree& other);
+    void merge(BinarySearchTree&& other) { merge(other); }
+    BinarySearchTree merge_union(const BinarySearchTree& other) const { return Combine<true, true, true>(other); }
+    BinarySearchTree intersect(const BinarySearchTree& other) const { return Combine<false, true, false>(other); }
+    BinarySearchTree difference(const BinarySearchTree& other) const { return Combine<true, false, false>(other); }
+    BinarySearchTree symmetric_difference(const BinarySearchTree& other) const { return Combine<true, false, true>(other); }
+    // These take the nodes of both trees instead of copying values and leave both trees empty. When one tree is much
+    // smaller and the policy keeps joins balanced they cost O(m log(n / m + 1)), otherwise O(n + m).
+    static BinarySearchTree merge_union(BinarySearchTree&& left, BinarySearchTree&& right) {
+        return Combine<true, true, true>(std::move(left), std::move(right));
+    }
+    static BinarySearchTree intersect(BinarySearchTree&& left, BinarySearchTree&& right) {
+        return Combine<false, true, false>(std::move(left), std::move(right));
+    }
+    static BinarySearchTree difference(BinarySearchTree&& left, BinarySearchTree&& right) {
+        return Combine<true, false, false>(std::move(left), std::move(right));
+    }
+    static BinarySearchTree symmetric_difference(BinarySearchTree&& left, BinarySearchTree&& right) {
+        return Combine<true, false, true>(std::move(left), std::move(right));
+    }
+    // O(log n) when IsOrderStatistic; otherwise the piece sizes cost another O(min(k, n - k)) to count. With
+    // RedBlackBalance every join step measures black heights, which makes split O(log^2 n).
+    std::pair<BinarySearchTree, BinarySearchTree> split(const T& key);
+    // O(log n), or O(log^2 n) with RedBlackBalance; O(1) when either tree is empty
+    static BinarySearchTree join(BinarySearchTree&& left, BinarySearchTree&& right);
+    size_t erase(const T& data);
+    size_t erase(const T& data, Node* &root);
+    InOrderIterator<false> erase(InOrderIterator<false> first, InOrderIterator<false> last);
+    size_t erase_range(const T& lo, const T& hi);
+    template <typename Predicate>
+    size_t erase_if(Predicate pred);
 
     void clear();
     bool contains(const T& data);
@@ -170,12 +345,48 @@ class BinarySearchTree {
     PreOrderIterator<false> upper_bound(const T& key, PreOrderTag);
     PostOrderIterator<false> upper_bound(const T& key, PostOrderTag);
     Node* upper_bound_node(const T& key);
+    std::pair<Node*, Node*> equal_range_node(const T& key);
+
+    template <typename OutputIt>
+    void find_batch(std::span<const T> keys, OutputIt out);
+    template <typename OutputIt>
+    void contains_batch(std::span<const T> keys, OutputIt out);
+    template <typename OutputIt>
+    void lower_bound_batch(std::span<const T> keys, OutputIt out);
+
+    FrozenBinarySearchTree<T, Compare> freeze() const;
+
+    InOrderIterator<false> nth_element(size_t index);
+    size_t rank(const T& key);
 
     std::pair<InOrderIterator<false>, InOrderIterator<false>> equal_range(const T& key) { return equal_range(key, InOrderTag{}); };
     std::pair<InOrderIterator<false>, InOrderIterator<false>> equal_range(const T& key, InOrderTag);
     std::pair<PreOrderIterator<false>, PreOrderIterator<false>> equal_range(const T& key, PreOrderTag);
     std::pair<PostOrderIterator<false>, PostOrderIterator<false>> equal_range(const T& key, PostOrderTag);
 
+    template <typename Key> requires TransparentCompare<Compare>
+    InOrderIterator<false> find(const Key& key) { return InOrderIterator<false>(AccessNode(key), this); }
+    template <typename Key> requires TransparentCompare<Compare>
+    bool contains(const Key& key) { return AccessNode(key) != nullptr; }
+    template <typename Key> requires TransparentCompare<Compare>
+    size_t count(const Key& key) { return CountKeys(key); }
+    template <typename Key> requires TransparentCompare<Compare>
+    InOrderIterator<false> lower_bound(const Key& key) { return InOrderIterator<false>(LowerBoundNode(key), this); }
+    template <typename Key> requires TransparentCompare<Compare>
+    InOrderIterator<false> upper_bound(const Key& key) { return InOrderIterator<false>(UpperBoundNode(key), this); }
+    template <typename Key> requires TransparentCompare<Compare>
+    Node* lower_bound_node(const Key& key) { return LowerBoundNode(key); }
+    template <typename Key> requires TransparentCompare<Compare>
+    Node* upper_bound_node(const Key& key) { return UpperBoundNode(key); }
+    template <typename Key> requires TransparentCompare<Compare>
+    std::pair<Node*, Node*> equal_range_node(const Key& key) { return EqualRangeNode(key); }
+    template <typename Key> requires TransparentCompare<Compare>
+    std::pair<InOrderIterator<false>, InOrderIterator<false>> equal_range(const Key& key) {
+        auto [lower, upper] = EqualRangeNode(key);
+
+        return std::make_pair(InOrderIterator<false>(lower, this), InOrderIterator<false>(upper, this));
+    }
+
     friend std::ostream& operator<<(std::ostream& out, const Node node) {
         out << (T)node.value;
 
@@ -183,33 +394,190 @@ class BinarySearchTree {
     }
 
  private:
+    Node* InsertNode(const T& data);
+    Node* LinkNode(Node* new_node);
+    Node* AttachNode(Node* new_node, Node* parent, bool as_left);
+    Node* LinkNodeNear(Node* hint, Node* new_node);
+    Node* FindUniquePosition(const T& key, Node*& parent, bool& as_left);
+    void RemoveNode(Node* node);
+    void DeleteNode(Node* node);
+    Node* DetachNode(Node* node);
+    void SwapWithSuccessor(Node* node, Node* successor);
+    template <typename Key>
+    Node* FindNode(const Key& key, Node* root);
+    template <typename Key>
+    Node* AccessNode(const Key& key);
+    template <typename Key>
+    Node* LowerBoundNode(const Key& key);
+    template <typename Key>
+    Node* UpperBoundNode(const Key& key);
+    template <typename Key>
+    std::pair<Node*, Node*> EqualRangeNode(const Key& key);
+    template <typename Key>
+    size_t CountKeys(const Key& key);
+    template <typename Lhs, typename Rhs>
+    bool Less(const Lhs& lhs, const Rhs& rhs) const;
+    template <typename Lhs, typename Rhs>
+    std::weak_ordering Order(const Lhs& lhs, const Rhs& rhs) const;
+    template <bool IsLowerBound>
+    void DescendBatch(const T* keys, size_t width, Node** found);
+    Node* CloneNode(const Node* node, Node* parent);
+    template <typename... Args>
+    Node* CreateNode(Args&&... args);
+    template <bool KeepLeft, bool KeepBoth, bool KeepRight>
+    BinarySearchTree Combine(const BinarySearchTree& other) const;
+    template <bool KeepLeft, bool KeepBoth, bool KeepRight>
+    static BinarySearchTree Combine(BinarySearchTree&& left, BinarySearchTree&& right);
+    template <bool KeepLeft, bool KeepBoth, bool KeepRight, bool PivotLeft>
+    Node* CombineNodes(Node* left, Node* right, size_t& dropped);
+    std::pair<Node*, Node*> SplitEqual(Node* root, const T& key, std::vector<Node*>& equal);
+    Node* Release();
+    Node* JoinTrees(Node* left, Node* right);
+    Node* JoinNodes(Node* left, Node* middle, Node* right);
+    std::pair<Node*, Node*> SplitAt(Node* node);
+    void LinkSubtrees(Node* node, Node* left, Node* right, Node* parent, bool as_left);
+    template <typename ForwardIt>
+    void Build(ForwardIt first, size_t count);
+    template <typename ForwardIt>
+    Node* BuildBalanced(ForwardIt& it, size_t count, size_t depth, size_t height);
+    Node* RelinkBalanced(Node* const* nodes, size_t count, size_t depth, size_t height);
+    void UpdateBoundaries();
+    bool IsMonotonic() const;
+    Node* FirstPostOrderNode() const;
+    size_t Index(const Node* node) const;
+    static size_t SubtreeSize(const Node* node);
+    static void UpdateSubtreeSize(Node* node);
+    void RotateLeft(Node* node);
+    void RotateRight(Node* node);
+
     Node* root_;
+    Node* leftmost_;
+    Node* rightmost_;
+    size_t size_;
     Compare compare_;
     NodeAllocator allocator_;
 };
 
-template<typename T, typename Compare, typename Allocator>
-size_t BinarySearchTree<T, Compare, Allocator>::count(const T &key) {
-    size_t count = 0;
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::nth_element(size_t index) {
+
+    if (index >= size_) {
+        return end(in);
+    }
+
+    if constexpr (IsOrderStatistic) {
+        Node* temp = root_;
+        while (temp != nullptr) {
+            size_t left = SubtreeSize(temp->left);
+
+            if (index < left) {
+                temp = temp->left;
+            } else if (index > left) {
+                index -= left + 1;
+                temp = temp->right;
+            } else {
+                break;
+            }
+        }
+
+        return InOrderIterator<false>(temp, this);
+    } else {
+        return std::next(begin(in), index);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rank(const T &key) {
+    if constexpr (IsOrderStatistic) {
+        size_t rank = 0;
+        Node* temp = root_;
+
+        while (temp != nullptr) {
+            if (Less(temp->value, key)) {
+                rank += SubtreeSize(temp->left) + 1;
+                temp = temp->right;
+            } else {
+                temp = temp->left;
+            }
+        }
+
+        return rank;
+    } else {
+        size_t rank = 0;
+        for (auto it = begin(in); it != end(in) && Less(*it, key); ++it) {
+            rank += 1;
+        }
+
+        return rank;
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Index(const Node* node) const {
+    if (node == nullptr) {
+        return size_;
+    }
 
-    for (auto it = this->begin(); it != this->end(); ++it) {
-        if (!compare_(key, *it) && !compare_(*it, key)) {
+    size_t index = SubtreeSize(node->left);
+    for (; node->parent != nullptr; node = node->parent) {
+        if (node == node->parent->right) {
+            index += SubtreeSize(node->parent->left) + 1;
+        }
+    }
+
+    return index;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::SubtreeSize(const Node* node) {
+    return (node != nullptr) ? node->subtree_size : 0;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::UpdateSubtreeSize(Node* node) {
+    node->subtree_size = 1 + SubtreeSize(node->left) + SubtreeSize(node->right);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::count(const T &key) {
+    return CountKeys(key);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::CountKeys(const Key& key) {
+    auto [lower, upper] = EqualRangeNode(key);
+
+    if constexpr (IsOrderStatistic) {
+        return Index(upper) - Index(lower);
+    } else {
+        size_t count = 0;
+        for (auto it = InOrderIterator<false>(lower, this); it.Get() != upper; ++it) {
             count += 1;
         }
+
+        return count;
     }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::lower_bound_node(const T &key) {
 
-    return count;
+    return LowerBoundNode(key);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::Node*
-    BinarySearchTree<T, Compare, Allocator>::lower_bound_node(const T &key) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::LowerBoundNode(const Key& key) {
 
     Node* current = root_;
     Node* last = nullptr;
 
     while (current != nullptr) {
-        if (compare_(current->value, key)) {
+        if (Less(current->value, key)) {
             current = current->right;
         } else {
             last = current;
@@ -220,15 +588,23 @@ BinarySearchTree<T, Compare, Allocator>::Node*
     return last;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::Node*
-    BinarySearchTree<T, Compare, Allocator>::upper_bound_node(const T &key) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::upper_bound_node(const T &key) {
+
+    return UpperBoundNode(key);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::UpperBoundNode(const Key& key) {
 
     Node* current = root_;
     Node* last = nullptr;
 
     while (current != nullptr) {
-        if (!compare_(key, current->value)) {
+        if (!Less(key, current->value)) {
             current = current->right;
         } else {
             last = current;
@@ -239,714 +615,1972 @@ BinarySearchTree<T, Compare, Allocator>::Node*
     return last;
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<false>,
-          typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::equal_range(const T &key, InOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::equal_range_node(const T &key) {
+
+    return EqualRangeNode(key);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::EqualRangeNode(const Key& key) {
+
+    Node* current = root_;
+    Node* upper = nullptr;
+
+    while (current != nullptr) {
+        std::weak_ordering order = Order(key, current->value);
+
+        if (order > 0) {
+            current = current->right;
+        } else if (order < 0) {
+            upper = current;
+            current = current->left;
+        } else {
+            Node* lower = current;
+
+            for (Node* temp = current->left; temp != nullptr;) {
+                if (Less(temp->value, key)) {
+                    temp = temp->right;
+                } else {
+                    lower = temp;
+                    temp = temp->left;
+                }
+            }
+
+            for (Node* temp = current->right; temp != nullptr;) {
+                if (Less(key, temp->value)) {
+                    upper = temp;
+                    temp = temp->left;
+                } else {
+                    temp = temp->right;
+                }
+            }
+
+            return std::make_pair(lower, upper);
+        }
+    }
+
+    return std::make_pair(upper, upper);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::equal_range(const T &key, InOrderTag) {
+
+    auto [lower, upper] = equal_range_node(key);
 
-    return std::make_pair(lower_bound(key, in), upper_bound(key, in));
+    return std::make_pair(InOrderIterator<false>(lower, this), InOrderIterator<false>(upper, this));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<false>,
-          typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::equal_range(const T &key, PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<false>,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::equal_range(const T &key, PreOrderTag) {
 
-    return std::make_pair(lower_bound(key, pre), upper_bound(key, pre));
+    auto [lower, upper] = equal_range_node(key);
+
+    return std::make_pair(PreOrderIterator<false>(lower, this), PreOrderIterator<false>(upper, this));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<false>,
-          typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::equal_range(const T &key, PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<false>,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::equal_range(const T &key, PostOrderTag) {
+
+    auto [lower, upper] = equal_range_node(key);
 
-    return std::make_pair(lower_bound(key, post), upper_bound(key, post));
+    return std::make_pair(PostOrderIterator<false>(lower, this), PostOrderIterator<false>(upper, this));
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::upper_bound(const T &key, InOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::upper_bound(const T &key, InOrderTag) {
 
     return InOrderIterator<false>(upper_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::upper_bound(const T &key, PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::upper_bound(const T &key, PreOrderTag) {
 
     return PreOrderIterator<false>(upper_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::upper_bound(const T &key, PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::upper_bound(const T &key, PostOrderTag) {
 
     return PostOrderIterator<false>(upper_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::lower_bound(const T &key, InOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::lower_bound(const T &key, InOrderTag) {
 
     return InOrderIterator<false>(lower_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::lower_bound(const T &key, PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::lower_bound(const T &key, PreOrderTag) {
 
     return PreOrderIterator<false>(lower_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::lower_bound(const T &key, PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::lower_bound(const T &key, PostOrderTag) {
 
     return PostOrderIterator<false>(lower_bound_node(key), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-T BinarySearchTree<T, Compare, Allocator>::extract(const T &data) {
-    T node = T();
-    extract(data, root_, node);
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::node_type
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::extract(const T &data) {
 
-    return node;
-}
+    Node* found = FindNode(data, root_);
+    if (found == nullptr) {
+        return node_type();
+    }
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::extract(const T &data, BinarySearchTree::Node* &root, T& node) {
+    return node_type(DetachNode(found), allocator_);
+}
 
-    if (root == nullptr) {
-        return;
-    }
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::node_type
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::extract(InOrderIterator<false> position) {
 
-    if (compare_(data, root->value)) {
-        extract(data, root->left, node);
-    } else if (compare_(root->value, data)) {
-        extract(data, root->right, node);
-    } else {
-        if (node == T()) {
-            node = root->value;
-        }
+    return node_type(DetachNode(position.Get()), allocator_);
+}
 
-        if (root->left == nullptr) {
-            Node* temp = root->right;
-            if (temp) {
-                temp->parent = root->parent;
-            }
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(node_type&& node) {
 
-            std::allocator_traits<NodeAllocator>::destroy(allocator_, root);
-            std::allocator_traits<NodeAllocator>::deallocate(allocator_, root, kOneNode);
+    if (node.empty()) {
+        return end(in);
+    }
 
-            root = temp;
-        } else if (root->right == nullptr) {
-            Node* temp = root->left;
-            if (temp) {
-                temp->parent = root->parent;
-            }
+    return InOrderIterator<false>(LinkNode(node.Release()), this);
+}
 
-            std::allocator_traits<NodeAllocator>::destroy(allocator_, root);
-            std::allocator_traits<NodeAllocator>::deallocate(allocator_, root, kOneNode);
+// Moves every node of other into this tree. Nodes are relinked when the allocators are interchangeable
+// and copied otherwise.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::merge(BinarySearchTree& other) {
+    if (&other == this) {
+        return;
+    }
 
-            root = temp;
+    bool relink = (allocator_ == other.allocator_);
+    while (other.root_ != nullptr) {
+        if (relink) {
+            LinkNode(other.DetachNode(other.leftmost_));
         } else {
-            Node* min_node = root->right;
-            while (min_node && min_node->left != nullptr) {
-                min_node = min_node->left;
-            }
-            root->value = min_node->value;
-
-            extract(min_node->value, root->right, node);
+            InsertNode(other.leftmost_->value);
+            other.RemoveNode(other.leftmost_);
         }
     }
 }
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::clear() {
-    Destroy(this->root_);
-
-    this->root_ = nullptr;
-}
+// Walks both trees in order like std::set_union and its siblings: equal keys are paired off one to one, and the
+// flags choose whether keys found only on the left, on both sides or only on the right are kept. Values are copied
+// while their node is still in cache and then moved into a balanced tree, so no node is visited twice.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <bool KeepLeft, bool KeepBoth, bool KeepRight>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Combine(const BinarySearchTree& other) const {
 
-template<typename T, typename Compare, typename Allocator>
-bool BinarySearchTree<T, Compare, Allocator>::contains(const T& data) {
-    return this->find(data) != this->end(in);
-}
+    std::vector<T> values;
+    values.reserve(size_ + (KeepRight ? other.size_ : 0));
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::find(const T &data, InOrderTag) {
+    auto lhs = cbegin(in);
+    auto rhs = other.cbegin(in);
+    while (lhs != cend(in) && rhs != other.cend(in)) {
+        std::weak_ordering order = Order(*lhs, *rhs);
 
-    Node* temp = root_;
-    while (temp != this->end(in).Get()) {
-        if (compare_(data, temp->value)) {
-            temp = temp->left;
-        } else if (compare_(temp->value, data)) {
-            temp = temp->right;
+        if (order < 0) {
+            if constexpr (KeepLeft) {
+                values.push_back(*lhs);
+            }
+            ++lhs;
+        } else if (order > 0) {
+            if constexpr (KeepRight) {
+                values.push_back(*rhs);
+            }
+            ++rhs;
         } else {
-            return InOrderIterator<false>(temp, this);
+            if constexpr (KeepBoth) {
+                values.push_back(*lhs);
+            }
+            ++lhs;
+            ++rhs;
         }
     }
 
-    return this->end(in);
-}
+    for (; KeepLeft && lhs != cend(in); ++lhs) {
+        values.push_back(*lhs);
+    }
+    for (; KeepRight && rhs != other.cend(in); ++rhs) {
+        values.push_back(*rhs);
+    }
+
+    BinarySearchTree result(compare_, get_allocator());
+    result.Build(std::make_move_iterator(values.begin()), values.size());
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::erase(const T &data) {
-    erase(data, root_);
+    return result;
 }
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::erase(const T& data, Node* &root) {
-    if (root == nullptr) {
-        return;
+// Takes over the nodes of both trees. A much smaller tree is combined into the larger one by splitting it at every
+// key of the smaller one, so only O(m log(n / m + 1)) nodes are visited; otherwise both trees are walked once and the
+// nodes that stay are relinked into a balanced tree. Trees whose allocators cannot free each other's nodes are
+// copied like the const overloads do.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <bool KeepLeft, bool KeepBoth, bool KeepRight>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Combine(BinarySearchTree&& left,
+                                                                                     BinarySearchTree&& right) {
+    if (left.allocator_ != right.allocator_) {
+        return std::as_const(left).template Combine<KeepLeft, KeepBoth, KeepRight>(right);
     }
 
-    if (compare_(data, root->value)) {
-        erase(data, root->left);
-    } else if (compare_(root->value, data)) {
-        erase(data, root->right);
-    } else {
-        if (root->left == nullptr) {
-            Node* temp = root->right;
-            if (temp) {
-                temp->parent = root->parent;
-            }
-
-            std::allocator_traits<NodeAllocator>::destroy(allocator_, root);
-            std::allocator_traits<NodeAllocator>::deallocate(allocator_, root, kOneNode);
-
-            root = temp;
-        } else if (root->right == nullptr) {
-            Node* temp = root->left;
-            if (temp) {
-                temp->parent = root->parent;
-            }
+    BinarySearchTree result(left.compare_, left.get_allocator());
+    size_t total = left.size_ + right.size_;
+    size_t dropped = 0;
 
-            std::allocator_traits<NodeAllocator>::destroy(allocator_, root);
-            std::allocator_traits<NodeAllocator>::deallocate(allocator_, root, kOneNode);
+    if (BalancePolicy::kBalanced && std::min(left.size_, right.size_) * kJoinRatio < std::max(left.size_, right.size_)) {
+        bool pivot_left = left.size_ < right.size_;
+        Node* lhs = left.Release();
+        Node* rhs = right.Release();
 
-            root = temp;
+        if (pivot_left) {
+            result.root_ = result.template CombineNodes<KeepLeft, KeepBoth, KeepRight, true>(lhs, rhs, dropped);
         } else {
-            Node* min_node = root->right;
-            while (min_node && min_node->left != nullptr) {
-                min_node = min_node->left;
-            }
-            root->value = min_node->value;
-
-            erase(min_node->value, root->right);
+            result.root_ = result.template CombineNodes<KeepLeft, KeepBoth, KeepRight, false>(lhs, rhs, dropped);
         }
-    }
-}
-
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<false>, bool>
-    BinarySearchTree<T, Compare, Allocator>::insert(const T& data, InOrderTag) {
-
-    Node* new_node = std::allocator_traits<NodeAllocator>::allocate(allocator_, kOneNode);
-    std::allocator_traits<NodeAllocator>::construct(allocator_, new_node, data);
-
-    if (root_ == nullptr) {
-        root_ = new_node;
     } else {
-        Node* temp = root_;
-        Node* parent = nullptr;
-
-        while (temp != nullptr) {
-            parent = temp;
-
-            if (compare_(data, temp->value)) {
-                temp = temp->left;
+        std::vector<Node*> kept;
+        std::vector<Node*> removed;
+        kept.reserve(left.size_ + (KeepRight ? right.size_ : 0));
+
+        auto lhs = left.begin(in);
+        auto rhs = right.begin(in);
+        while (lhs != left.end(in) && rhs != right.end(in)) {
+            std::weak_ordering order = left.Order(*lhs, *rhs);
+
+            if (order < 0) {
+                (KeepLeft ? kept : removed).push_back(lhs.Get());
+                ++lhs;
+            } else if (order > 0) {
+                (KeepRight ? kept : removed).push_back(rhs.Get());
+                ++rhs;
             } else {
-                temp = temp->right;
+                (KeepBoth ? kept : removed).push_back(lhs.Get());
+                removed.push_back(rhs.Get());
+                ++lhs;
+                ++rhs;
             }
         }
 
-        new_node->parent = parent;
-
-        if (compare_(data, parent->value)) {
-            parent->left = new_node;
-        } else {
-            parent->right = new_node;
+        for (; lhs != left.end(in); ++lhs) {
+            (KeepLeft ? kept : removed).push_back(lhs.Get());
+        }
+        for (; rhs != right.end(in); ++rhs) {
+            (KeepRight ? kept : removed).push_back(rhs.Get());
         }
-    }
 
-    return std::make_pair(InOrderIterator<false>(new_node, this), true);
-}
+        left.Release();
+        right.Release();
 
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<false>, bool>
-    BinarySearchTree<T, Compare, Allocator>::insert(const T& data, PreOrderTag) {
+        for (Node* node : removed) {
+            result.DeleteNode(node);
+        }
+        dropped = removed.size();
 
-    Node* new_node = std::allocator_traits<NodeAllocator>::allocate(allocator_, kOneNode);
-    std::allocator_traits<NodeAllocator>::construct(allocator_, new_node, data);
+        result.root_ = result.RelinkBalanced(kept.data(), kept.size(), 0, std::bit_width(kept.size()));
+        if (result.root_) {
+            result.root_->parent = nullptr;
+        }
+    }
 
-    if (root_ == nullptr) {
-        root_ = new_node;
-    } else {
-        Node* temp = root_;
-        Node* parent = nullptr;
+    result.size_ = total - dropped;
+    result.UpdateBoundaries();
 
-        while (temp != nullptr) {
-            parent = temp;
+    return result;
+}
 
-            if (compare_(data, temp->value)) {
-                temp = temp->left;
-            } else {
-                temp = temp->right;
-            }
+// Splits both detached subtrees around the root key of the pivot side, combines the halves recursively and joins
+// them back around the equal nodes that stay. Equal nodes pair off one to one in order, as in the linear walk.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <bool KeepLeft, bool KeepBoth, bool KeepRight, bool PivotLeft>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::CombineNodes(Node* left, Node* right,
+                                                                                          size_t& dropped) {
+    if (left == nullptr || right == nullptr) {
+        Node* rest = (left != nullptr) ? left : right;
+        if ((left != nullptr) ? KeepLeft : KeepRight) {
+            return rest;
         }
 
-        new_node->parent = parent;
+        dropped += Destroy(rest);
 
-        if (compare_(data, parent->value)) {
-            parent->left = new_node;
+        return nullptr;
+    }
+
+    const T& key = PivotLeft ? left->value : right->value;
+    std::vector<Node*> left_equal;
+    std::vector<Node*> right_equal;
+    auto [left_less, left_greater] = SplitEqual(left, key, left_equal);
+    auto [right_less, right_greater] = SplitEqual(right, key, right_equal);
+
+    std::vector<Node*> middle;
+    size_t pairs = std::min(left_equal.size(), right_equal.size());
+    for (size_t i = 0; i < left_equal.size(); ++i) {
+        if (i < pairs ? KeepBoth : KeepLeft) {
+            middle.push_back(left_equal[i]);
         } else {
-            parent->right = new_node;
+            DeleteNode(left_equal[i]);
+            dropped += 1;
+        }
+    }
+    for (size_t i = 0; i < right_equal.size(); ++i) {
+        if (i >= pairs && KeepRight) {
+            middle.push_back(right_equal[i]);
+        } else {
+            DeleteNode(right_equal[i]);
+            dropped += 1;
         }
     }
 
-    return std::make_pair(PreOrderIterator<false>(new_node, this), true);
-}
-
-template<typename T, typename Compare, typename Allocator>
-std::pair<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<false>, bool>
-    BinarySearchTree<T, Compare, Allocator>::insert(const T& data, PostOrderTag) {
+    Node* lower = CombineNodes<KeepLeft, KeepBoth, KeepRight, PivotLeft>(left_less, right_less, dropped);
+    Node* upper = CombineNodes<KeepLeft, KeepBoth, KeepRight, PivotLeft>(left_greater, right_greater, dropped);
 
-    Node* new_node = std::allocator_traits<NodeAllocator>::allocate(allocator_, kOneNode);
-    std::allocator_traits<NodeAllocator>::construct(allocator_, new_node, data);
+    if (middle.empty()) {
+        return JoinTrees(lower, upper);
+    }
 
-    if (root_ == nullptr) {
-        root_ = new_node;
-    } else {
-        Node* temp = root_;
-        Node* parent = nullptr;
+    for (size_t i = 0; i + 1 < middle.size(); ++i) {
+        lower = JoinNodes(lower, middle[i], nullptr);
+    }
 
-        while (temp != nullptr) {
-            parent = temp;
+    return JoinNodes(lower, middle.back(), upper);
+}
 
-            if (compare_(data, temp->value)) {
-                temp = temp->left;
-            } else {
-                temp = temp->right;
-            }
+// Cuts a detached subtree into the nodes less than key and the nodes greater than it, and appends the nodes equal to
+// key to equal in order
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::SplitEqual(Node* root, const T& key,
+                                                                                        std::vector<Node*>& equal) {
+    Node* first = nullptr;
+    for (Node* node = root; node != nullptr;) {
+        if (Less(node->value, key)) {
+            node = node->right;
+        } else {
+            first = node;
+            node = node->left;
         }
+    }
+
+    if (first == nullptr) {
+        return {root, nullptr};
+    }
+
+    auto [less, rest] = SplitAt(first);
+    if (Less(key, first->value)) {
+        return {less, JoinNodes(nullptr, first, rest)};
+    }
+    equal.push_back(first);
 
-        new_node->parent = parent;
+    Node* smallest = rest;
+    while (smallest != nullptr && smallest->left != nullptr) {
+        smallest = smallest->left;
+    }
+    if (smallest == nullptr || Less(key, smallest->value)) {
+        return {less, rest};
+    }
 
-        if (compare_(data, parent->value)) {
-            parent->left = new_node;
+    Node* after = nullptr;
+    for (Node* node = rest; node != nullptr;) {
+        if (Less(key, node->value)) {
+            after = node;
+            node = node->left;
         } else {
-            parent->right = new_node;
+            node = node->right;
         }
     }
 
-    return std::make_pair(PostOrderIterator<false>(new_node, this), true);
-}
+    Node* equal_root = rest;
+    Node* greater = nullptr;
+    if (after != nullptr) {
+        auto [same, beyond] = SplitAt(after);
+        equal_root = same;
+        greater = JoinNodes(nullptr, after, beyond);
+    }
 
-template<typename T, typename Compare, typename Allocator>
-bool BinarySearchTree<T, Compare, Allocator>::empty() const {
-    return (this->cbegin() == this->cend());
-}
+    Node* node = equal_root;
+    while (node != nullptr && node->left != nullptr) {
+        node = node->left;
+    }
+    while (node != nullptr) {
+        equal.push_back(node);
 
-template<typename T, typename Compare, typename Allocator>
-size_t BinarySearchTree<T, Compare, Allocator>::size() const {
-    return (std::distance(this->cbegin(), this->cend()));
-}
+        if (node->right != nullptr) {
+            node = node->right;
+            while (node->left != nullptr) {
+                node = node->left;
+            }
+        } else {
+            while (node->parent != nullptr && node == node->parent->right) {
+                node = node->parent;
+            }
+            node = node->parent;
+        }
+    }
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::swap(BinarySearchTree &binary_search_tree) {
-    std::swap(this->root_, binary_search_tree.root_);
-    std::swap(this->allocator_, binary_search_tree.allocator_);
-    std::swap(this->compare_, binary_search_tree.compare_);
+    return {less, greater};
 }
 
-template<typename T, typename Compare, typename Allocator>
-bool BinarySearchTree<T, Compare, Allocator>::operator!=(const BinarySearchTree &binary_search_tree) {
-    return !(*this == binary_search_tree);
-}
+// Concatenates two detached subtrees by cutting the largest node out of left and joining around it
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::JoinTrees(Node* left, Node* right) {
 
-template<typename T, typename Compare, typename Allocator>
-bool BinarySearchTree<T, Compare, Allocator>::IsEqual(Node* first, Node* second) {
-    if (first == nullptr && second == nullptr) {
-        return true;
-    }
-    if (first == nullptr || second == nullptr) {
-        return false;
+    if (left == nullptr || right == nullptr) {
+        return (left != nullptr) ? left : right;
     }
 
-    return (first->value == second->value) &&
-        IsEqual(first->left, second->left) &&
-        IsEqual(first->right, second->right);
-}
-
-template<typename T, typename Compare, typename Allocator>
-bool BinarySearchTree<T, Compare, Allocator>::operator==(const BinarySearchTree &binary_search_tree) {
-    if (this->size() != binary_search_tree.size()) {
-        return false;
+    Node* last = left;
+    while (last->right != nullptr) {
+        last = last->right;
     }
 
-    Node* first = this->root_;
-    Node* second = binary_search_tree.root_;
+    Node* before = SplitAt(last).first;
 
-    return IsEqual(first, second);
+    return JoinNodes(before, last, right);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::BinarySearchTree(const BinarySearchTree &binary_search_tree) {
-    this->compare_ = binary_search_tree.compare_;
-    this->allocator_ = binary_search_tree.allocator_;
-    this->root_ = Copy(binary_search_tree.root_);
-}
+// Hands the nodes over to the caller and leaves the tree empty without freeing anything
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Release() {
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::~BinarySearchTree() {
-    Destroy(this->root_);
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+
+    return std::exchange(root_, nullptr);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>
-&BinarySearchTree<T, Compare, Allocator>::operator=(const BinarySearchTree &binary_search_tree) {
+// Cuts the tree in front of the first node not less than key and joins the pieces hanging off the path to it
+// bottom-up, so only the nodes on the path are relinked and every join is bounded by the height of its pieces.
+// This tree is left empty. Without subtree sizes the smaller side has to be counted, which adds O(min(k, n - k)).
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>,
+          BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::split(const T& key) {
 
-    if (this != &binary_search_tree) {
-        Destroy(this->root_);
-        this->root_ = copy(binary_search_tree.root);
-        this->compare_ = binary_search_tree.compare;
-        this->allocator_ = binary_search_tree.allocator_;
+    std::pair<BinarySearchTree, BinarySearchTree> pieces(std::piecewise_construct,
+                                                         std::forward_as_tuple(compare_, get_allocator()),
+                                                         std::forward_as_tuple(compare_, get_allocator()));
+    BinarySearchTree& lower = pieces.first;
+    BinarySearchTree& upper = pieces.second;
+
+    Node* first_upper = LowerBoundNode(key);
+    if (first_upper == nullptr) {
+        lower.root_ = root_;
+    } else {
+        auto [before, after] = SplitAt(first_upper);
+        lower.root_ = before;
+        upper.root_ = JoinNodes(nullptr, first_upper, after);
     }
 
-    return *this;
+    lower.UpdateBoundaries();
+    upper.UpdateBoundaries();
+
+    if constexpr (IsOrderStatistic) {
+        lower.size_ = SubtreeSize(lower.root_);
+    } else {
+        auto lhs = lower.begin(in);
+        auto rhs = upper.begin(in);
+        size_t steps = 0;
+        for (; lhs != lower.end(in) && rhs != upper.end(in); ++lhs, ++rhs) {
+            ++steps;
+        }
+
+        lower.size_ = (lhs == lower.end(in)) ? steps : size_ - steps;
+    }
+    upper.size_ = size_ - lower.size_;
+
+    root_ = nullptr;
+    leftmost_ = nullptr;
+    rightmost_ = nullptr;
+    size_ = 0;
+
+    return pieces;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::Node*
-BinarySearchTree<T, Compare, Allocator>::Copy(const Node* node) {
+// Concatenates two trees whose keys do not overlap by taking the largest node of left as the middle of a join.
+// Overlapping keys or allocators that cannot share nodes fall back to merge.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::join(BinarySearchTree&& left,
+                                                                                  BinarySearchTree&& right) {
 
-    if (!node) {
-        return nullptr;
+    BinarySearchTree result(left.compare_, left.get_allocator());
+    result.swap(left);
+
+    if (right.root_ == nullptr) {
+        return result;
     }
 
-    Node* new_node = std::allocator_traits<NodeAllocator>::allocate(allocator_, kOneNode);
-    std::allocator_traits<NodeAllocator>::construct(allocator_, new_node, node->value, node->parent);
-    new_node->left = Copy(node->left);
-    new_node->right = Copy(node->right);
+    if (result.root_ == nullptr && result.allocator_ == right.allocator_) {
+        result.swap(right);
 
-    return new_node;
+        return result;
+    }
+
+    if (result.root_ == nullptr || result.allocator_ != right.allocator_ ||
+        result.Less(right.leftmost_->value, result.rightmost_->value)) {
+        result.merge(right);
+
+        return result;
+    }
+
+    Node* middle = result.DetachNode(result.rightmost_);
+    result.root_ = result.JoinNodes(result.root_, middle, right.root_);
+    result.size_ += right.size_ + 1;
+    result.UpdateBoundaries();
+
+    right.root_ = nullptr;
+    right.leftmost_ = nullptr;
+    right.rightmost_ = nullptr;
+    right.size_ = 0;
+
+    return result;
 }
 
-template<typename T, typename Compare, typename Allocator>
-void BinarySearchTree<T, Compare, Allocator>::Destroy(Node* node) {
-    if (node) {
-        Destroy(node->left);
-        Destroy(node->right);
-        std::allocator_traits<NodeAllocator>::destroy(allocator_, node);
-        std::allocator_traits<NodeAllocator>::deallocate(allocator_, node, kOneNode);
+// Unhooks node from the tree it belongs to and returns the detached trees of the nodes before and after it. Each
+// ancestor of node is joined onto one of the two sides with the subtree it keeps, from the bottom up.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*,
+          typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::SplitAt(Node* node) {
+
+    std::vector<std::pair<Node*, bool>> path;
+    for (Node* child = node; child->parent != nullptr; child = child->parent) {
+        path.emplace_back(child->parent, child == child->parent->right);
+    }
+
+    Node* lower = node->left;
+    Node* upper = node->right;
+    if (lower) {
+        lower->parent = nullptr;
+    }
+    if (upper) {
+        upper->parent = nullptr;
     }
+
+    for (auto [ancestor, is_lower] : path) {
+        if (is_lower) {
+            if (ancestor->left) {
+                ancestor->left->parent = nullptr;
+            }
+            lower = JoinNodes(ancestor->left, ancestor, lower);
+        } else {
+            if (ancestor->right) {
+                ancestor->right->parent = nullptr;
+            }
+            upper = JoinNodes(upper, ancestor, ancestor->right);
+        }
+    }
+
+    node->left = nullptr;
+    node->right = nullptr;
+    node->parent = nullptr;
+
+    return {lower, upper};
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T &BinarySearchTree<T, Compare, Allocator>::front(InOrderTag) const {
-    return *(this->cbegin(in));
+// The subtrees must be detached; the balance policy decides where middle goes and restores its invariant
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::JoinNodes(Node* left, Node* middle, Node* right) {
+
+    BalancePolicy::Join(*this, left, middle, right);
+
+    return root_;
 }
 
-template<typename T, typename Compare, typename Allocator>
-T &BinarySearchTree<T, Compare, Allocator>::front(InOrderTag) {
-    return *(this->begin(in));
+// Puts node in place of a child of parent (or at the top) with the given subtrees, then refreshes the subtree sizes
+// above it and points root_ at the top of the joined tree
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::LinkSubtrees(Node* node, Node* left, Node* right,
+                                                                                            Node* parent, bool as_left) {
+    node->left = left;
+    if (left) {
+        left->parent = node;
+    }
+
+    node->right = right;
+    if (right) {
+        right->parent = node;
+    }
+
+    node->parent = parent;
+    if (parent != nullptr) {
+        if (as_left) {
+            parent->left = node;
+        } else {
+            parent->right = node;
+        }
+    }
+
+    Node* top = node;
+    while (true) {
+        if constexpr (IsOrderStatistic) {
+            UpdateSubtreeSize(top);
+        }
+
+        if (top->parent == nullptr) {
+            break;
+        }
+        top = top->parent;
+    }
+
+    root_ = top;
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T &BinarySearchTree<T, Compare, Allocator>::back(InOrderTag) const {
-    return *(--this->cend(in));
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::clear() {
+    if (!IsMonotonic()) {
+        Destroy(this->root_);
+    } else if constexpr (requires(NodeAllocator& allocator) { allocator.release(); }) {
+        this->allocator_.release();
+    }
+
+    this->root_ = nullptr;
+    this->leftmost_ = nullptr;
+    this->rightmost_ = nullptr;
+    this->size_ = 0;
 }
 
-template<typename T, typename Compare, typename Allocator>
-T &BinarySearchTree<T, Compare, Allocator>::back(InOrderTag) {
-    return *(--this->end(in));
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::contains(const T& data) {
+    return this->find(data) != this->end(in);
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crend(InOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::find(const T &data, InOrderTag) {
 
-    return std::reverse_iterator<InOrderIterator<true>>(cbegin(in));
+    return InOrderIterator<false>(AccessNode(data), this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::erase(const T &data) {
+    return erase(data, root_);
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crbegin(InOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::erase(const T& data, Node* &root) {
+    Node* found = FindNode(data, root);
+    if (found == nullptr) {
+        return 0;
+    }
+
+    RemoveNode(found);
 
-    return std::reverse_iterator<InOrderIterator<true>>(cend(in));
+    return 1;
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rend(InOrderTag) {
+// Cuts the tree around both ends of the range and joins what is left around last, so the range goes away as whole
+// subtrees in O(k + log n) whatever its length
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::erase(InOrderIterator<false> first,
+                                                                                   InOrderIterator<false> last) {
+    if (first == last) {
+        return last;
+    }
 
-    return std::reverse_iterator<InOrderIterator<false>>(begin(in));
+    Node* first_node = first.Get();
+    Node* last_node = last.Get();
+
+    Node* upper = nullptr;
+    if (last_node != nullptr) {
+        std::tie(root_, upper) = SplitAt(last_node);
+    }
+
+    auto [lower, middle] = SplitAt(first_node);
+    size_t erased = Destroy(middle) + 1;
+    DeleteNode(first_node);
+
+    if (last_node != nullptr) {
+        root_ = JoinNodes(lower, last_node, upper);
+    } else {
+        root_ = lower;
+    }
+    size_ -= erased;
+
+    UpdateBoundaries();
+
+    return InOrderIterator<false>(last_node, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template InOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rbegin(InOrderTag) {
+// Erases the keys in [lo, hi) and returns how many there were
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::erase_range(const T& lo, const T& hi) {
+    if (!Less(lo, hi)) {
+        return 0;
+    }
 
-    return std::reverse_iterator<InOrderIterator<false>>(end(in));
+    size_t size = size_;
+    erase(InOrderIterator<false>(LowerBoundNode(lo), this), InOrderIterator<false>(LowerBoundNode(hi), this));
+
+    return size - size_;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cend(InOrderTag) const {
+// Tests every value once in order and relinks the survivors into a balanced tree without moving or reallocating
+// them, which is O(n) against O(k log n) for erasing the matches one by one. A throwing predicate leaves the tree
+// untouched.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Predicate>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::erase_if(Predicate pred) {
+    std::vector<Node*> kept;
+    std::vector<Node*> erased;
+    kept.reserve(size_);
+
+    for (auto it = begin(in); it != end(in); ++it) {
+        if (pred(std::as_const(*it))) {
+            erased.push_back(it.Get());
+        } else {
+            kept.push_back(it.Get());
+        }
+    }
+
+    if (erased.empty()) {
+        return 0;
+    }
 
-    Node* rightmost = this->root_;
-    while (rightmost) {
-        rightmost = rightmost->right;
+    for (Node* node : erased) {
+        DeleteNode(node);
     }
 
-    return InOrderIterator<true>(rightmost, this);
+    root_ = RelinkBalanced(kept.data(), kept.size(), 0, std::bit_width(kept.size()));
+    if (root_) {
+        root_->parent = nullptr;
+    }
+    size_ = kept.size();
+
+    UpdateBoundaries();
+
+    return erased.size();
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cbegin(InOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::FindNode(const Key& key, Node* root) {
 
-    Node* leftmost = root_;
-    while (leftmost) {
-        if (leftmost->left == nullptr) {
-            break;
+    while (root != nullptr) {
+        std::weak_ordering order = Order(key, root->value);
+
+        if (order < 0) {
+            root = root->left;
+        } else if (order > 0) {
+            root = root->right;
+        } else {
+            return root;
         }
+    }
 
-        leftmost = leftmost->left;
+    return nullptr;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InsertNode(const T& data) {
+
+    return LinkNode(CreateNode(data));
+}
+
+// Hangs a detached node under its leaf position and lets the policy rebalance
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::LinkNode(Node* new_node) {
+
+    Node* temp = root_;
+    Node* parent = nullptr;
+    bool as_left = false;
+
+    while (temp != nullptr) {
+        parent = temp;
+        as_left = Less(new_node->value, temp->value);
+        temp = as_left ? temp->left : temp->right;
+    }
+
+    return AttachNode(new_node, parent, as_left);
+}
+
+// Links a node as the given child of a parent whose slot is known to be free
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::AttachNode(Node* new_node, Node* parent, bool as_left) {
+
+    new_node->parent = parent;
+
+    if (parent == nullptr) {
+        root_ = new_node;
+        leftmost_ = new_node;
+        rightmost_ = new_node;
+    } else if (as_left) {
+        parent->left = new_node;
+        if (parent == leftmost_) {
+            leftmost_ = new_node;
+        }
+    } else {
+        parent->right = new_node;
+        if (parent == rightmost_) {
+            rightmost_ = new_node;
+        }
+    }
+
+    if constexpr (IsOrderStatistic) {
+        for (Node* temp = new_node->parent; temp != nullptr; temp = temp->parent) {
+            temp->subtree_size += 1;
+        }
     }
 
-    return InOrderIterator<true>(leftmost, this);
+    BalancePolicy::AfterInsert(*this, new_node);
+    size_ += 1;
+
+    return new_node;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::end(InOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Key>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::AccessNode(const Key& key) {
 
-    Node* rightmost = this->root_;
-    while (rightmost) {
-        rightmost = rightmost->right;
+    Node* found = FindNode(key, root_);
+    if (found != nullptr) {
+        BalancePolicy::AfterAccess(*this, found);
     }
 
-    return InOrderIterator<false>(rightmost, this);
+    return found;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::InOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::begin(InOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Lhs, typename Rhs>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Less(const Lhs& lhs, const Rhs& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, Lhs, Rhs>) {
+        return compare_(lhs, rhs) < 0;
+    } else {
+        return compare_(lhs, rhs);
+    }
+}
 
-    Node* leftmost = root_;
-    while (leftmost) {
-        if (leftmost->left == nullptr) {
-            break;
+// One comparator call per node when Compare returns an ordering or is std::less over types with a total <=>,
+// two calls otherwise
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename Lhs, typename Rhs>
+std::weak_ordering BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Order(const Lhs& lhs, const Rhs& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, Lhs, Rhs>) {
+        return compare_(lhs, rhs);
+    } else if constexpr ((std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>) &&
+                         std::three_way_comparable_with<Lhs, Rhs, std::weak_ordering>) {
+        return lhs <=> rhs;
+    } else if (Less(lhs, rhs)) {
+        return std::weak_ordering::less;
+    } else if (Less(rhs, lhs)) {
+        return std::weak_ordering::greater;
+    } else {
+        return std::weak_ordering::equivalent;
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename OutputIt>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::find_batch(std::span<const T> keys, OutputIt out) {
+    std::array<Node*, kBatchWidth> found;
+
+    for (size_t group = 0; group < keys.size(); group += kBatchWidth) {
+        size_t width = std::min(kBatchWidth, keys.size() - group);
+        DescendBatch<false>(keys.data() + group, width, found.data());
+
+        for (size_t i = 0; i < width; ++i) {
+            if (found[i] != nullptr) {
+                BalancePolicy::AfterAccess(*this, found[i]);
+            }
+
+            *out++ = InOrderIterator<false>(found[i], this);
         }
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename OutputIt>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::contains_batch(std::span<const T> keys, OutputIt out) {
+    std::array<Node*, kBatchWidth> found;
+
+    for (size_t group = 0; group < keys.size(); group += kBatchWidth) {
+        size_t width = std::min(kBatchWidth, keys.size() - group);
+        DescendBatch<false>(keys.data() + group, width, found.data());
 
-        leftmost = leftmost->left;
+        for (size_t i = 0; i < width; ++i) {
+            if (found[i] != nullptr) {
+                BalancePolicy::AfterAccess(*this, found[i]);
+            }
+
+            *out++ = (found[i] != nullptr);
+        }
     }
+}
 
-    return InOrderIterator<false>(leftmost, this);
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename OutputIt>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::lower_bound_batch(std::span<const T> keys, OutputIt out) {
+    std::array<Node*, kBatchWidth> found;
+
+    for (size_t group = 0; group < keys.size(); group += kBatchWidth) {
+        size_t width = std::min(kBatchWidth, keys.size() - group);
+        DescendBatch<true>(keys.data() + group, width, found.data());
+
+        for (size_t i = 0; i < width; ++i) {
+            *out++ = InOrderIterator<false>(found[i], this);
+        }
+    }
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::find(const T &data, PostOrderTag) {
+// Walks up to kBatchWidth independent descents in lockstep, one level per round, and prefetches the next node
+// of every query so that the cache misses of different queries overlap instead of queueing up
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <bool IsLowerBound>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::DescendBatch(const T* keys, size_t width, Node** found) {
+    std::array<Node*, kBatchWidth> current;
+    for (size_t i = 0; i < width; ++i) {
+        current[i] = root_;
+        found[i] = nullptr;
+    }
+
+    for (bool active = (root_ != nullptr); active;) {
+        active = false;
+
+        for (size_t i = 0; i < width; ++i) {
+            Node* node = current[i];
+            if (node == nullptr) {
+                continue;
+            }
+
+            if constexpr (IsLowerBound) {
+                if (Less(node->value, keys[i])) {
+                    node = node->right;
+                } else {
+                    found[i] = node;
+                    node = node->left;
+                }
+            } else {
+                std::weak_ordering order = Order(keys[i], node->value);
+
+                if (order == 0) {
+                    found[i] = node;
+                    node = nullptr;
+                } else {
+                    node = (order < 0) ? node->left : node->right;
+                }
+            }
+
+            if (node != nullptr) {
+                Prefetch(node);
+                active = true;
+            }
+            current[i] = node;
+        }
+    }
+}
+
+// Links a node just before the hint when it fits between the hint and its in-order neighbour, which needs
+// no descent from the root. A hint that does not fit falls back to the usual descent.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::LinkNodeNear(Node* hint, Node* new_node) {
+
+    const T& key = new_node->value;
+
+    if (hint == nullptr) {
+        if (rightmost_ != nullptr && !Less(key, rightmost_->value)) {
+            return AttachNode(new_node, rightmost_, false);
+        }
+    } else if (!Less(hint->value, key)) {
+        if (hint == leftmost_) {
+            return AttachNode(new_node, hint, true);
+        }
+
+        Node* before = (--InOrderIterator<false>(hint, this)).Get();
+        if (!Less(key, before->value)) {
+            return (before->right == nullptr) ? AttachNode(new_node, before, false) : AttachNode(new_node, hint, true);
+        }
+    } else {
+        if (hint == rightmost_) {
+            return AttachNode(new_node, hint, false);
+        }
+
+        Node* after = (++InOrderIterator<false>(hint, this)).Get();
+        if (!Less(after->value, key)) {
+            return (hint->right == nullptr) ? AttachNode(new_node, hint, false) : AttachNode(new_node, after, true);
+        }
+    }
+
+    return LinkNode(new_node);
+}
+
+// Returns the node equal to key, or nullptr together with the slot a new key would be linked into
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::FindUniquePosition(const T& key, Node*& parent, bool& as_left) {
 
     Node* temp = root_;
-    while (temp != this->end(in).Get()) {
-        if (compare_(data, temp->value)) {
+    parent = nullptr;
+    as_left = false;
+
+    while (temp != nullptr) {
+        std::weak_ordering order = Order(key, temp->value);
+
+        if (order < 0) {
+            parent = temp;
+            as_left = true;
             temp = temp->left;
-        } else if (compare_(temp->value, data)) {
+        } else if (order > 0) {
+            parent = temp;
+            as_left = false;
             temp = temp->right;
         } else {
-            return PostOrderIterator<false>(temp, this);
+            return temp;
         }
     }
 
-    return this->end(post);
+    return nullptr;
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::find(const T &data, PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(T&& data) {
 
-    Node* temp = root_;
-    while (temp != this->end(in).Get()) {
-        if (compare_(data, temp->value)) {
-            temp = temp->left;
-        } else if (compare_(temp->value, data)) {
-            temp = temp->right;
+    return emplace(std::move(data));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename... Args>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::emplace(Args&&... args) {
+
+    Node* new_node = LinkNode(CreateNode(std::in_place, std::forward<Args>(args)...));
+
+    return std::make_pair(InOrderIterator<false>(new_node, this), true);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename... Args>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::emplace_hint(InOrderIterator<false> hint, Args&&... args) {
+
+    Node* new_node = CreateNode(std::in_place, std::forward<Args>(args)...);
+
+    return InOrderIterator<false>(LinkNodeNear(hint.Get(), new_node), this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(InOrderIterator<false> hint, const T& data) {
+
+    return emplace_hint(hint, data);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(InOrderIterator<false> hint, T&& data) {
+
+    return emplace_hint(hint, std::move(data));
+}
+
+// Inserts only if no equal key is present. A single argument of type T is looked up before anything is allocated;
+// other argument lists have to be constructed first and the node is dropped on a hit.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename... Args>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::emplace_unique(Args&&... args) {
+
+    Node* parent;
+    bool as_left;
+
+    if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...)) {
+        Node* found = FindUniquePosition(args..., parent, as_left);
+        if (found != nullptr) {
+            return std::make_pair(InOrderIterator<false>(found, this), false);
+        }
+
+        Node* new_node = CreateNode(std::in_place, std::forward<Args>(args)...);
+
+        return std::make_pair(InOrderIterator<false>(AttachNode(new_node, parent, as_left), this), true);
+    } else {
+        Node* new_node = CreateNode(std::in_place, std::forward<Args>(args)...);
+
+        Node* found = FindUniquePosition(new_node->value, parent, as_left);
+        if (found != nullptr) {
+            DeleteNode(new_node);
+
+            return std::make_pair(InOrderIterator<false>(found, this), false);
+        }
+
+        return std::make_pair(InOrderIterator<false>(AttachNode(new_node, parent, as_left), this), true);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::RemoveNode(Node* removed) {
+    DeleteNode(DetachNode(removed));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::DeleteNode(Node* node) {
+    std::allocator_traits<NodeAllocator>::destroy(allocator_, node);
+    std::allocator_traits<NodeAllocator>::deallocate(allocator_, node, kOneNode);
+}
+
+// Splices a node out of the tree and lets the policy restore its invariants. A node with two children first
+// trades places with its successor, so values never move between nodes.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::DetachNode(Node* removed) {
+
+    if (removed->left != nullptr && removed->right != nullptr) {
+        Node* successor = removed->right;
+        while (successor->left != nullptr) {
+            successor = successor->left;
+        }
+
+        SwapWithSuccessor(removed, successor);
+    }
+
+    Node* child = (removed->left != nullptr) ? removed->left : removed->right;
+    Node* parent = removed->parent;
+
+    if (removed == leftmost_) {
+        leftmost_ = parent;
+        for (Node* temp = removed->right; temp != nullptr; temp = temp->left) {
+            leftmost_ = temp;
+        }
+    }
+    if (removed == rightmost_) {
+        rightmost_ = parent;
+        for (Node* temp = removed->left; temp != nullptr; temp = temp->right) {
+            rightmost_ = temp;
+        }
+    }
+
+    if (child) {
+        child->parent = parent;
+    }
+
+    if (parent == nullptr) {
+        root_ = child;
+    } else if (parent->left == removed) {
+        parent->left = child;
+    } else {
+        parent->right = child;
+    }
+
+    if constexpr (IsOrderStatistic) {
+        for (Node* temp = parent; temp != nullptr; temp = temp->parent) {
+            temp->subtree_size -= 1;
+        }
+    }
+
+    BalancePolicy::AfterErase(*this, removed, child, parent);
+    size_ -= 1;
+
+    static_cast<typename BalancePolicy::NodeBase&>(*removed) = typename BalancePolicy::NodeBase();
+    if constexpr (IsOrderStatistic) {
+        removed->subtree_size = 1;
+    }
+    removed->left = nullptr;
+    removed->right = nullptr;
+    removed->parent = nullptr;
+
+    return removed;
+}
+
+// Exchanges the tree positions of a node and its in-order successor, together with the balance and size data
+// that belong to a position rather than to a value
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::SwapWithSuccessor(Node* node, Node* successor) {
+    Node* parent = node->parent;
+    Node* left = node->left;
+    Node* right = node->right;
+
+    successor->left = left;
+    left->parent = successor;
+    node->left = nullptr;
+    node->right = successor->right;
+
+    if (successor == right) {
+        successor->right = node;
+        node->parent = successor;
+    } else {
+        node->parent = successor->parent;
+        successor->parent->left = node;
+        successor->right = right;
+        right->parent = successor;
+    }
+
+    if (node->right != nullptr) {
+        node->right->parent = node;
+    }
+
+    successor->parent = parent;
+    if (parent == nullptr) {
+        root_ = successor;
+    } else if (parent->left == node) {
+        parent->left = successor;
+    } else {
+        parent->right = successor;
+    }
+
+    std::swap(static_cast<typename BalancePolicy::NodeBase&>(*node),
+              static_cast<typename BalancePolicy::NodeBase&>(*successor));
+    if constexpr (IsOrderStatistic) {
+        std::swap(node->subtree_size, successor->subtree_size);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::UpdateBoundaries() {
+    leftmost_ = root_;
+    while (leftmost_ && leftmost_->left) {
+        leftmost_ = leftmost_->left;
+    }
+
+    rightmost_ = root_;
+    while (rightmost_ && rightmost_->right) {
+        rightmost_ = rightmost_->right;
+    }
+}
+
+// Post-order starts at the first leaf below the leftmost node, which is usually the leftmost node itself. The walk
+// is bounded by the height of the leftmost node's right subtree: at most one for red-black and AVL trees, where this
+// is O(1), and up to the tree height for the other policies. Caching the leaf instead would need every rotation to
+// maintain it.
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::FirstPostOrderNode() const {
+
+    Node* node = leftmost_;
+    while (node && (node->left || node->right)) {
+        node = (node->left != nullptr) ? node->left : node->right;
+    }
+
+    return node;
+}
+
+// Nodes can be dropped without a walk when they need no destructor and the allocator never reclaims single nodes
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::IsMonotonic() const {
+    if constexpr (!std::is_trivially_destructible_v<Node>) {
+        return false;
+    } else if constexpr (requires { typename NodeAllocator::is_monotonic; }) {
+        return NodeAllocator::is_monotonic::value;
+    } else if constexpr (std::is_same_v<NodeAllocator, std::pmr::polymorphic_allocator<Node>>) {
+        return dynamic_cast<std::pmr::monotonic_buffer_resource*>(allocator_.resource()) != nullptr;
+    } else {
+        return false;
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::RotateLeft(Node* node) {
+    Node* pivot = node->right;
+
+    node->right = pivot->left;
+    if (pivot->left) {
+        pivot->left->parent = node;
+    }
+
+    pivot->parent = node->parent;
+    if (node->parent == nullptr) {
+        root_ = pivot;
+    } else if (node == node->parent->left) {
+        node->parent->left = pivot;
+    } else {
+        node->parent->right = pivot;
+    }
+
+    pivot->left = node;
+    node->parent = pivot;
+
+    if constexpr (IsOrderStatistic) {
+        UpdateSubtreeSize(node);
+        UpdateSubtreeSize(pivot);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::RotateRight(Node* node) {
+    Node* pivot = node->left;
+
+    node->left = pivot->right;
+    if (pivot->right) {
+        pivot->right->parent = node;
+    }
+
+    pivot->parent = node->parent;
+    if (node->parent == nullptr) {
+        root_ = pivot;
+    } else if (node == node->parent->right) {
+        node->parent->right = pivot;
+    } else {
+        node->parent->left = pivot;
+    }
+
+    pivot->right = node;
+    node->parent = pivot;
+
+    if constexpr (IsOrderStatistic) {
+        UpdateSubtreeSize(node);
+        UpdateSubtreeSize(pivot);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(const T& data, InOrderTag) {
+
+    Node* new_node = InsertNode(data);
+
+    return std::make_pair(InOrderIterator<false>(new_node, this), true);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(const T& data, PreOrderTag) {
+
+    Node* new_node = InsertNode(data);
+
+    return std::make_pair(PreOrderIterator<false>(new_node, this), true);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::pair<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<false>, bool>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::insert(const T& data, PostOrderTag) {
+
+    Node* new_node = InsertNode(data);
+
+    return std::make_pair(PostOrderIterator<false>(new_node, this), true);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::empty() const {
+    return (this->size_ == 0);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::size() const {
+    return this->size_;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::swap(BinarySearchTree &binary_search_tree) {
+    std::swap(this->root_, binary_search_tree.root_);
+    std::swap(this->leftmost_, binary_search_tree.leftmost_);
+    std::swap(this->rightmost_, binary_search_tree.rightmost_);
+    std::swap(this->size_, binary_search_tree.size_);
+    std::swap(this->compare_, binary_search_tree.compare_);
+
+    if constexpr (std::allocator_traits<NodeAllocator>::propagate_on_container_swap::value) {
+        std::swap(this->allocator_, binary_search_tree.allocator_);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::operator!=(const BinarySearchTree &binary_search_tree) {
+    return !(*this == binary_search_tree);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::IsEqual(Node* first, Node* second) {
+    if (first == nullptr || second == nullptr) {
+        return first == second;
+    }
+
+    Node* lhs = first;
+    Node* rhs = second;
+
+    while (true) {
+        if (!(lhs->value == rhs->value) ||
+            (lhs->left == nullptr) != (rhs->left == nullptr) ||
+            (lhs->right == nullptr) != (rhs->right == nullptr)) {
+
+            return false;
+        }
+
+        if (lhs->left != nullptr) {
+            lhs = lhs->left;
+            rhs = rhs->left;
+        } else if (lhs->right != nullptr) {
+            lhs = lhs->right;
+            rhs = rhs->right;
+        } else {
+            while (lhs != first && (lhs == lhs->parent->right || lhs->parent->right == nullptr)) {
+                lhs = lhs->parent;
+                rhs = rhs->parent;
+            }
+
+            if (lhs == first) {
+                return true;
+            }
+
+            lhs = lhs->parent->right;
+            rhs = rhs->parent->right;
+        }
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+bool BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::operator==(const BinarySearchTree &binary_search_tree) {
+    if (this->size() != binary_search_tree.size()) {
+        return false;
+    }
+
+    Node* first = this->root_;
+    Node* second = binary_search_tree.root_;
+
+    return IsEqual(first, second);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::BinarySearchTree(const BinarySearchTree &binary_search_tree)
+    : root_(nullptr), leftmost_(nullptr), rightmost_(nullptr), size_(0), compare_(binary_search_tree.compare_),
+      allocator_(std::allocator_traits<NodeAllocator>::select_on_container_copy_construction(binary_search_tree.allocator_)) {
+
+    this->root_ = Copy(binary_search_tree.root_);
+    this->size_ = binary_search_tree.size_;
+    UpdateBoundaries();
+}
+
+// Takes over the nodes; the source is left empty
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::BinarySearchTree(BinarySearchTree&& binary_search_tree) noexcept
+    : root_(binary_search_tree.root_), leftmost_(binary_search_tree.leftmost_), rightmost_(binary_search_tree.rightmost_),
+      size_(binary_search_tree.size_), compare_(binary_search_tree.compare_), allocator_(binary_search_tree.allocator_) {
+
+    binary_search_tree.root_ = nullptr;
+    binary_search_tree.leftmost_ = nullptr;
+    binary_search_tree.rightmost_ = nullptr;
+    binary_search_tree.size_ = 0;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::~BinarySearchTree() {
+    if (!IsMonotonic()) {
+        Destroy(this->root_);
+    }
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>
+&BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::operator=(const BinarySearchTree &binary_search_tree) {
+
+    if (this != &binary_search_tree) {
+        clear();
+        this->compare_ = binary_search_tree.compare_;
+        if constexpr (std::allocator_traits<NodeAllocator>::propagate_on_container_copy_assignment::value) {
+            this->allocator_ = binary_search_tree.allocator_;
+        }
+        this->root_ = Copy(binary_search_tree.root_);
+        this->size_ = binary_search_tree.size_;
+        UpdateBoundaries();
+    }
+
+    return *this;
+}
+
+// Nodes can only change hands when this tree's allocator can free them, otherwise the values are copied
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>
+&BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::operator=(BinarySearchTree&& binary_search_tree)
+    noexcept(kNothrowMoveAssign) {
+
+    if (this == &binary_search_tree) {
+        return *this;
+    }
+
+    constexpr bool kPropagate = std::allocator_traits<NodeAllocator>::propagate_on_container_move_assignment::value;
+    if (!kPropagate && this->allocator_ != binary_search_tree.allocator_) {
+        return *this = static_cast<const BinarySearchTree&>(binary_search_tree);
+    }
+
+    // A monotonic allocator that compares equal shares the arena with the source, so it must not be released
+    if (!IsMonotonic()) {
+        Destroy(this->root_);
+    }
+    if constexpr (kPropagate) {
+        this->allocator_ = binary_search_tree.allocator_;
+    }
+    this->compare_ = binary_search_tree.compare_;
+    this->root_ = std::exchange(binary_search_tree.root_, nullptr);
+    this->leftmost_ = std::exchange(binary_search_tree.leftmost_, nullptr);
+    this->rightmost_ = std::exchange(binary_search_tree.rightmost_, nullptr);
+    this->size_ = std::exchange(binary_search_tree.size_, 0);
+
+    return *this;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Copy(const Node* node) {
+
+    if (!node) {
+        return nullptr;
+    }
+
+    Node* new_root = CloneNode(node, nullptr);
+    const Node* source = node;
+    Node* target = new_root;
+
+    try {
+        while (true) {
+            if (source->left != nullptr && target->left == nullptr) {
+                target->left = CloneNode(source->left, target);
+                source = source->left;
+                target = target->left;
+            } else if (source->right != nullptr && target->right == nullptr) {
+                target->right = CloneNode(source->right, target);
+                source = source->right;
+                target = target->right;
+            } else if (source != node) {
+                source = source->parent;
+                target = target->parent;
+            } else {
+                break;
+            }
+        }
+    } catch (...) {
+        Destroy(new_root);
+        throw;
+    }
+
+    return new_root;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::CloneNode(const Node* node, Node* parent) {
+
+    Node* new_node = CreateNode(*node);
+    new_node->left = nullptr;
+    new_node->right = nullptr;
+    new_node->parent = parent;
+
+    return new_node;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename... Args>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::CreateNode(Args&&... args) {
+
+    Node* new_node = std::allocator_traits<NodeAllocator>::allocate(allocator_, kOneNode);
+    try {
+        std::allocator_traits<NodeAllocator>::construct(allocator_, new_node, std::forward<Args>(args)...);
+    } catch (...) {
+        std::allocator_traits<NodeAllocator>::deallocate(allocator_, new_node, kOneNode);
+        throw;
+    }
+
+    return new_node;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <std::input_iterator InputIt>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::assign(InputIt first, InputIt last) {
+    clear();
+
+    if constexpr (std::forward_iterator<InputIt>) {
+        if (std::is_sorted(first, last, value_comp())) {
+            Build(first, static_cast<size_t>(std::distance(first, last)));
+
+            return;
+        }
+    }
+
+    std::vector<T> values(first, last);
+    std::stable_sort(values.begin(), values.end(), value_comp());
+
+    Build(values.begin(), values.size());
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename ForwardIt>
+void BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Build(ForwardIt first, size_t count) {
+    root_ = BuildBalanced(first, count, 0, std::bit_width(count));
+    size_ = count;
+
+    UpdateBoundaries();
+}
+
+// Builds a tree whose subtree sizes differ by at most one from count sorted values, consuming them in order
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+template <typename ForwardIt>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::BuildBalanced(ForwardIt& it, size_t count,
+                                                                                        size_t depth, size_t height) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t left_count = (count - 1) / 2;
+    Node* left = BuildBalanced(it, left_count, depth + 1, height);
+
+    Node* node = nullptr;
+    try {
+        node = CreateNode(std::in_place, *it);
+    } catch (...) {
+        Destroy(left);
+        throw;
+    }
+    ++it;
+
+    node->left = left;
+    if (left) {
+        left->parent = node;
+    }
+
+    try {
+        node->right = BuildBalanced(it, count - left_count - 1, depth + 1, height);
+    } catch (...) {
+        Destroy(node);
+        throw;
+    }
+
+    if (node->right) {
+        node->right->parent = node;
+    }
+
+    if constexpr (IsOrderStatistic) {
+        node->subtree_size = count;
+    }
+
+    BalancePolicy::AfterBuild(node, depth, height);
+
+    return node;
+}
+
+// Gives count nodes that are already in order the shape BuildBalanced would, keeping their values in place
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Node*
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::RelinkBalanced(Node* const* nodes, size_t count,
+                                                                                         size_t depth, size_t height) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t left_count = (count - 1) / 2;
+    Node* node = nodes[left_count];
+
+    node->left = RelinkBalanced(nodes, left_count, depth + 1, height);
+    if (node->left) {
+        node->left->parent = node;
+    }
+
+    node->right = RelinkBalanced(nodes + left_count + 1, count - left_count - 1, depth + 1, height);
+    if (node->right) {
+        node->right->parent = node;
+    }
+
+    if constexpr (IsOrderStatistic) {
+        node->subtree_size = count;
+    }
+
+    BalancePolicy::AfterBuild(node, depth, height);
+
+    return node;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+size_t BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::Destroy(Node* node) {
+    Node* stop = (node != nullptr) ? node->parent : nullptr;
+    size_t destroyed = 0;
+
+    while (node != stop) {
+        if (node->left != nullptr) {
+            node = node->left;
+        } else if (node->right != nullptr) {
+            node = node->right;
         } else {
-            return PreOrderIterator<false>(temp, this);
+            Node* parent = node->parent;
+            if (parent != stop) {
+                if (parent->left == node) {
+                    parent->left = nullptr;
+                } else {
+                    parent->right = nullptr;
+                }
+            }
+
+            std::allocator_traits<NodeAllocator>::destroy(allocator_, node);
+            std::allocator_traits<NodeAllocator>::deallocate(allocator_, node, kOneNode);
+            ++destroyed;
+
+            node = parent;
         }
     }
 
-    return this->end(pre);
+    return destroyed;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T &BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(InOrderTag) const {
+    return *(this->cbegin(in));
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T& BinarySearchTree<T, Compare, Allocator>::back(PostOrderTag) const {
-    return *(--this->cend(post));
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T &BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(InOrderTag) {
+    return *(this->begin(in));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T &BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(InOrderTag) const {
+    return rightmost_->value;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T &BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(InOrderTag) {
+    return rightmost_->value;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crend(InOrderTag) const {
+
+    return std::reverse_iterator<InOrderIterator<true>>(cbegin(in));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crbegin(InOrderTag) const {
+
+    return std::reverse_iterator<InOrderIterator<true>>(cend(in));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rend(InOrderTag) {
+
+    return std::reverse_iterator<InOrderIterator<false>>(begin(in));
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T& BinarySearchTree<T, Compare, Allocator>::back(PreOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template InOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rbegin(InOrderTag) {
+
+    return std::reverse_iterator<InOrderIterator<false>>(end(in));
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cend(InOrderTag) const {
+
+    return InOrderIterator<true>(nullptr, this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cbegin(InOrderTag) const {
+
+    return InOrderIterator<true>(leftmost_, this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::end(InOrderTag) {
+
+    return InOrderIterator<false>(nullptr, this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::begin(InOrderTag) {
+
+    return InOrderIterator<false>(leftmost_, this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::find(const T &data, PostOrderTag) {
+
+    return PostOrderIterator<false>(AccessNode(data), this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::find(const T &data, PreOrderTag) {
+
+    return PreOrderIterator<false>(AccessNode(data), this);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(PostOrderTag) const {
+    return root_->value;
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(PreOrderTag) const {
     return *(--this->cend(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-T& BinarySearchTree<T, Compare, Allocator>::back(PostOrderTag) {
-    return *(--this->end(post));
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(PostOrderTag) {
+    return root_->value;
 }
 
-template<typename T, typename Compare, typename Allocator>
-T& BinarySearchTree<T, Compare, Allocator>::back(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::back(PreOrderTag) {
     return *(--this->end(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T& BinarySearchTree<T, Compare, Allocator>::front(PostOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(PostOrderTag) const {
     return *(this->cbegin(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-const T& BinarySearchTree<T, Compare, Allocator>::front(PreOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+const T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(PreOrderTag) const {
     return *(this->cbegin(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-T& BinarySearchTree<T, Compare, Allocator>::front(PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T& BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(PostOrderTag) {
     return *(this->begin(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-T &BinarySearchTree<T, Compare, Allocator>::front(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+T &BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::front(PreOrderTag) {
     return *(this->begin(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crend(PostOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crend(PostOrderTag) const {
 
     return std::reverse_iterator<PostOrderIterator<true>>(cbegin(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crend(PreOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crend(PreOrderTag) const {
 
     return std::reverse_iterator<PreOrderIterator<true>>(cbegin(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crbegin(PostOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crbegin(PostOrderTag) const {
     return std::reverse_iterator<PostOrderIterator<true>>(cend(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<true>>
-    BinarySearchTree<T, Compare, Allocator>::crbegin(PreOrderTag) const {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<true>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::crbegin(PreOrderTag) const {
 
     return std::reverse_iterator<PreOrderIterator<true>>(cend(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rend(PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rend(PostOrderTag) {
 
     return std::reverse_iterator<PostOrderIterator<false>>(begin(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rend(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rend(PreOrderTag) {
 
     return std::reverse_iterator<PreOrderIterator<false>>(begin(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PostOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rbegin(PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PostOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rbegin(PostOrderTag) {
 
     return std::reverse_iterator<PostOrderIterator<false>>(end(post));
 }
 
-template<typename T, typename Compare, typename Allocator>
-std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator>::template PreOrderIterator<false>>
-    BinarySearchTree<T, Compare, Allocator>::rbegin(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+std::reverse_iterator<typename BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::template PreOrderIterator<false>>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::rbegin(PreOrderTag) {
 
     return std::reverse_iterator<PreOrderIterator<false>>(end(pre));
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cend(PostOrderTag) {
-
-    auto it = cbegin(post);
-    auto end = PostOrderIterator<true>(nullptr, this);
-    while (it != end) {
-        ++it;
-    }
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cend(PostOrderTag) {
 
-    return it;
+    return PostOrderIterator<true>(nullptr, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cend(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cend(PreOrderTag) {
 
     return PreOrderIterator<true>(nullptr, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cbegin(PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cbegin(PostOrderTag) {
 
-    Node* min = this->root_;
-    while (min->left) {
-        min = min->left;
-    }
-
-    return PostOrderIterator<true>(min, this);
+    return PostOrderIterator<true>(FirstPostOrderNode(), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<true>
-    BinarySearchTree<T, Compare, Allocator>::cbegin(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<true>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::cbegin(PreOrderTag) {
 
     return PreOrderIterator<true>(this->root_, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::end(PostOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::end(PostOrderTag) {
 
     return PostOrderIterator<false>(nullptr, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::end(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::end(PreOrderTag) {
 
     return PreOrderIterator<false>(nullptr, this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PostOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::begin(PostOrderTag) {
-
-    Node* min = this->root_;
-    while (min->left) {
-        min = min->left;
-    }
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::begin(PostOrderTag) {
 
-    return PostOrderIterator<false>(min, this);
+    return PostOrderIterator<false>(FirstPostOrderNode(), this);
 }
 
-template<typename T, typename Compare, typename Allocator>
-BinarySearchTree<T, Compare, Allocator>::PreOrderIterator<false>
-    BinarySearchTree<T, Compare, Allocator>::begin(PreOrderTag) {
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator<false>
+    BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::begin(PreOrderTag) {
 
     return PreOrderIterator<false>(this->root_, this);
 }
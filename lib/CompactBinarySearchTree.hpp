@@ -0,0 +1,700 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <compare>
+#include <iterator>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+
+#include "BinarySearchTree.hpp"
+
+// Binary search tree whose nodes live in one vector and link through 32-bit indices instead of pointers.
+// An int32_t node takes 16 bytes instead of 32 plus the per-allocation overhead of the pointer layout, and
+// iterators stay valid when the vector grows because they hold indices. Erased slots are recycled through a
+// free list. Like BinarySearchTree with NoBalance, the shape depends on the insertion order, and ranges
+// build a balanced tree.
+template <typename T, typename Compare = std::less<T>>
+class CompactBinarySearchTree {
+ private:
+    using Index = uint32_t;
+
+    static constexpr Index kNull = std::numeric_limits<Index>::max();
+
+    struct Node {
+        T value;
+        Index left;
+        Index right;
+        Index parent;
+    };
+
+ public:
+    template <typename OrderTag, bool IsConst>
+    class Iterator;
+
+    template <bool IsConst>
+    using InOrderIterator = Iterator<InOrderTag, IsConst>;
+    template <bool IsConst>
+    using PreOrderIterator = Iterator<PreOrderTag, IsConst>;
+    template <bool IsConst>
+    using PostOrderIterator = Iterator<PostOrderTag, IsConst>;
+
+    CompactBinarySearchTree() : root_(kNull), leftmost_(kNull), rightmost_(kNull), free_(kNull), size_(0), compare_{} {}
+    explicit CompactBinarySearchTree(const Compare& comp)
+        : root_(kNull), leftmost_(kNull), rightmost_(kNull), free_(kNull), size_(0), compare_(comp) {}
+    template <std::input_iterator InputIt>
+    CompactBinarySearchTree(InputIt first, InputIt last, const Compare& comp = Compare())
+        : root_(kNull), leftmost_(kNull), rightmost_(kNull), free_(kNull), size_(0), compare_(comp) {
+        assign(first, last);
+    }
+
+    template <std::input_iterator InputIt>
+    void assign(InputIt first, InputIt last);
+
+    Compare key_comp() const { return compare_; }
+
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, false> begin(OrderTag = OrderTag()) { return Iterator<OrderTag, false>(First(OrderTag()), this); }
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, false> end(OrderTag = OrderTag()) { return Iterator<OrderTag, false>(kNull, this); }
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, true> begin(OrderTag = OrderTag()) const { return Iterator<OrderTag, true>(First(OrderTag()), this); }
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, true> end(OrderTag = OrderTag()) const { return Iterator<OrderTag, true>(kNull, this); }
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, true> cbegin(OrderTag = OrderTag()) const { return begin(OrderTag()); }
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, true> cend(OrderTag = OrderTag()) const { return end(OrderTag()); }
+
+    template <typename OrderTag = InOrderTag>
+    std::reverse_iterator<Iterator<OrderTag, false>> rbegin(OrderTag = OrderTag()) {
+        return std::reverse_iterator<Iterator<OrderTag, false>>(end(OrderTag()));
+    }
+    template <typename OrderTag = InOrderTag>
+    std::reverse_iterator<Iterator<OrderTag, false>> rend(OrderTag = OrderTag()) {
+        return std::reverse_iterator<Iterator<OrderTag, false>>(begin(OrderTag()));
+    }
+
+    [[nodiscard]] size_t size() const { return size_; }
+    [[nodiscard]] bool empty() const { return size_ == 0; }
+    [[nodiscard]] size_t capacity() const { return nodes_.capacity(); }
+    [[nodiscard]] size_t memory_usage() const { return nodes_.capacity() * sizeof(Node); }
+    static constexpr size_t node_size() { return sizeof(Node); }
+    void reserve(size_t count) { nodes_.reserve(count); }
+
+    T& front() { return nodes_[leftmost_].value; }
+    const T& front() const { return nodes_[leftmost_].value; }
+    T& back() { return nodes_[rightmost_].value; }
+    const T& back() const { return nodes_[rightmost_].value; }
+
+    std::pair<InOrderIterator<false>, bool> insert(const T& data) { return emplace(data); }
+    std::pair<InOrderIterator<false>, bool> insert(T&& data) { return emplace(std::move(data)); }
+    template <typename... Args>
+    std::pair<InOrderIterator<false>, bool> emplace(Args&&... args);
+    size_t erase(const T& data);
+    void clear();
+    void swap(CompactBinarySearchTree& other);
+
+    template <typename OrderTag = InOrderTag>
+    Iterator<OrderTag, false> find(const T& data, OrderTag = OrderTag()) {
+        return Iterator<OrderTag, false>(FindIndex(data), this);
+    }
+    bool contains(const T& data) const { return FindIndex(data) != kNull; }
+    size_t count(const T& key) const;
+    InOrderIterator<false> lower_bound(const T& key) { return InOrderIterator<false>(LowerBoundIndex(key), this); }
+    InOrderIterator<false> upper_bound(const T& key) { return InOrderIterator<false>(UpperBoundIndex(key), this); }
+
+    bool operator==(const CompactBinarySearchTree& other) const;
+    bool operator!=(const CompactBinarySearchTree& other) const { return !(*this == other); }
+
+ private:
+    Index FindIndex(const T& data) const;
+    Index LowerBoundIndex(const T& key) const;
+    Index UpperBoundIndex(const T& key) const;
+    bool Less(const T& lhs, const T& rhs) const;
+    std::weak_ordering Order(const T& lhs, const T& rhs) const;
+    template <typename... Args>
+    Index CreateNode(Args&&... args);
+    void SwapWithSuccessor(Index node, Index successor);
+    template <typename ForwardIt>
+    Index BuildBalanced(ForwardIt& it, size_t count, Index parent);
+
+    Index First(InOrderTag) const;
+    Index First(PreOrderTag) const;
+    Index First(PostOrderTag) const;
+    Index Next(Index index, InOrderTag) const;
+    Index Next(Index index, PreOrderTag) const;
+    Index Next(Index index, PostOrderTag) const;
+    Index Prev(Index index, InOrderTag) const;
+    Index Prev(Index index, PreOrderTag) const;
+    Index Prev(Index index, PostOrderTag) const;
+
+    std::vector<Node> nodes_;
+    Index root_;
+    Index leftmost_;
+    Index rightmost_;
+    Index free_;
+    size_t size_;
+    Compare compare_;
+};
+
+template <typename T, typename Compare>
+template <typename OrderTag, bool IsConst>
+class CompactBinarySearchTree<T, Compare>::Iterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = T;
+    using pointer           = std::conditional_t<IsConst, const T*, T*>;
+    using reference         = std::conditional_t<IsConst, const T&, T&>;
+    using conditional_tree  = std::conditional_t<IsConst, const CompactBinarySearchTree*, CompactBinarySearchTree*>;
+
+    Iterator() : index_(kNull), tree_(nullptr) {}
+    Iterator(Index index, conditional_tree tree) : index_(index), tree_(tree) {}
+
+    operator Iterator<OrderTag, true>() const {
+        return Iterator<OrderTag, true>(index_, tree_);
+    }
+
+    Iterator& operator++() {
+        index_ = tree_->Next(index_, OrderTag());
+
+        return *this;
+    }
+
+    Iterator operator++(int32_t) {
+        Iterator temp = *this;
+        ++(*this);
+
+        return temp;
+    }
+
+    Iterator& operator--() {
+        index_ = tree_->Prev(index_, OrderTag());
+
+        return *this;
+    }
+
+    Iterator operator--(int32_t) {
+        Iterator temp = *this;
+        --(*this);
+
+        return temp;
+    }
+
+    reference operator*() const {
+        return tree_->nodes_[index_].value;
+    }
+
+    pointer operator->() const {
+        return &tree_->nodes_[index_].value;
+    }
+
+    bool operator==(const Iterator& other) const {
+        return index_ == other.index_ && tree_ == other.tree_;
+    }
+
+    bool operator!=(const Iterator& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    Index index_;
+    conditional_tree tree_;
+};
+
+template <typename T, typename Compare>
+template <std::input_iterator InputIt>
+void CompactBinarySearchTree<T, Compare>::assign(InputIt first, InputIt last) {
+    clear();
+
+    std::vector<T> values(first, last);
+    auto less = [this](const T& lhs, const T& rhs) { return Less(lhs, rhs); };
+    if (!std::is_sorted(values.begin(), values.end(), less)) {
+        std::stable_sort(values.begin(), values.end(), less);
+    }
+
+    if (values.size() >= kNull) {
+        throw std::length_error("CompactBinarySearchTree is limited to 2^32 - 1 nodes");
+    }
+
+    nodes_.reserve(values.size());
+    auto it = values.begin();
+    root_ = BuildBalanced(it, values.size(), kNull);
+    size_ = values.size();
+
+    leftmost_ = root_;
+    while (leftmost_ != kNull && nodes_[leftmost_].left != kNull) {
+        leftmost_ = nodes_[leftmost_].left;
+    }
+
+    rightmost_ = root_;
+    while (rightmost_ != kNull && nodes_[rightmost_].right != kNull) {
+        rightmost_ = nodes_[rightmost_].right;
+    }
+}
+
+// Places every subtree root before its children, so a descent moves forward through the vector
+template <typename T, typename Compare>
+template <typename ForwardIt>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::BuildBalanced(ForwardIt& it, size_t count, Index parent) {
+
+    if (count == 0) {
+        return kNull;
+    }
+
+    size_t left_count = (count - 1) / 2;
+    ForwardIt middle = std::next(it, left_count);
+
+    Index node = CreateNode(std::move(*middle));
+    nodes_[node].parent = parent;
+
+    Index left = BuildBalanced(it, left_count, node);
+    ++it;
+    Index right = BuildBalanced(it, count - left_count - 1, node);
+
+    nodes_[node].left = left;
+    nodes_[node].right = right;
+
+    return node;
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+typename CompactBinarySearchTree<T, Compare>::Index CompactBinarySearchTree<T, Compare>::CreateNode(Args&&... args) {
+    if (free_ != kNull) {
+        Index index = free_;
+        free_ = nodes_[index].left;
+        nodes_[index] = Node{T(std::forward<Args>(args)...), kNull, kNull, kNull};
+
+        return index;
+    }
+
+    if (nodes_.size() >= kNull) {
+        throw std::length_error("CompactBinarySearchTree is limited to 2^32 - 1 nodes");
+    }
+
+    nodes_.push_back(Node{T(std::forward<Args>(args)...), kNull, kNull, kNull});
+
+    return static_cast<Index>(nodes_.size() - 1);
+}
+
+template <typename T, typename Compare>
+template <typename... Args>
+std::pair<typename CompactBinarySearchTree<T, Compare>::template InOrderIterator<false>, bool>
+    CompactBinarySearchTree<T, Compare>::emplace(Args&&... args) {
+
+    Index new_node = CreateNode(std::forward<Args>(args)...);
+    const T& data = nodes_[new_node].value;
+
+    Index parent = kNull;
+    bool as_left = false;
+    for (Index temp = root_; temp != kNull;) {
+        parent = temp;
+        as_left = Less(data, nodes_[temp].value);
+        temp = as_left ? nodes_[temp].left : nodes_[temp].right;
+    }
+
+    nodes_[new_node].parent = parent;
+    if (parent == kNull) {
+        root_ = new_node;
+        leftmost_ = new_node;
+        rightmost_ = new_node;
+    } else if (as_left) {
+        nodes_[parent].left = new_node;
+        if (parent == leftmost_) {
+            leftmost_ = new_node;
+        }
+    } else {
+        nodes_[parent].right = new_node;
+        if (parent == rightmost_) {
+            rightmost_ = new_node;
+        }
+    }
+
+    size_ += 1;
+
+    return std::make_pair(InOrderIterator<false>(new_node, this), true);
+}
+
+template <typename T, typename Compare>
+size_t CompactBinarySearchTree<T, Compare>::erase(const T& data) {
+    Index removed = FindIndex(data);
+    if (removed == kNull) {
+        return 0;
+    }
+
+    if (nodes_[removed].left != kNull && nodes_[removed].right != kNull) {
+        Index successor = nodes_[removed].right;
+        while (nodes_[successor].left != kNull) {
+            successor = nodes_[successor].left;
+        }
+
+        SwapWithSuccessor(removed, successor);
+    }
+
+    Node& node = nodes_[removed];
+    Index child = (node.left != kNull) ? node.left : node.right;
+    Index parent = node.parent;
+
+    if (removed == leftmost_) {
+        leftmost_ = parent;
+        for (Index temp = node.right; temp != kNull; temp = nodes_[temp].left) {
+            leftmost_ = temp;
+        }
+    }
+    if (removed == rightmost_) {
+        rightmost_ = parent;
+        for (Index temp = node.left; temp != kNull; temp = nodes_[temp].right) {
+            rightmost_ = temp;
+        }
+    }
+
+    if (child != kNull) {
+        nodes_[child].parent = parent;
+    }
+
+    if (parent == kNull) {
+        root_ = child;
+    } else if (nodes_[parent].left == removed) {
+        nodes_[parent].left = child;
+    } else {
+        nodes_[parent].right = child;
+    }
+
+    if constexpr (std::is_default_constructible_v<T>) {
+        node.value = T();
+    }
+    node.left = free_;
+    node.right = kNull;
+    node.parent = kNull;
+    free_ = removed;
+    size_ -= 1;
+
+    return 1;
+}
+
+// Exchanges the tree positions of a node and its in-order successor, so values never move between slots
+template <typename T, typename Compare>
+void CompactBinarySearchTree<T, Compare>::SwapWithSuccessor(Index node, Index successor) {
+    Index parent = nodes_[node].parent;
+    Index left = nodes_[node].left;
+    Index right = nodes_[node].right;
+
+    nodes_[successor].left = left;
+    nodes_[left].parent = successor;
+    nodes_[node].left = kNull;
+    nodes_[node].right = nodes_[successor].right;
+
+    if (successor == right) {
+        nodes_[successor].right = node;
+        nodes_[node].parent = successor;
+    } else {
+        nodes_[node].parent = nodes_[successor].parent;
+        nodes_[nodes_[successor].parent].left = node;
+        nodes_[successor].right = right;
+        nodes_[right].parent = successor;
+    }
+
+    if (nodes_[node].right != kNull) {
+        nodes_[nodes_[node].right].parent = node;
+    }
+
+    nodes_[successor].parent = parent;
+    if (parent == kNull) {
+        root_ = successor;
+    } else if (nodes_[parent].left == node) {
+        nodes_[parent].left = successor;
+    } else {
+        nodes_[parent].right = successor;
+    }
+}
+
+template <typename T, typename Compare>
+void CompactBinarySearchTree<T, Compare>::clear() {
+    nodes_.clear();
+    root_ = kNull;
+    leftmost_ = kNull;
+    rightmost_ = kNull;
+    free_ = kNull;
+    size_ = 0;
+}
+
+template <typename T, typename Compare>
+void CompactBinarySearchTree<T, Compare>::swap(CompactBinarySearchTree& other) {
+    std::swap(nodes_, other.nodes_);
+    std::swap(root_, other.root_);
+    std::swap(leftmost_, other.leftmost_);
+    std::swap(rightmost_, other.rightmost_);
+    std::swap(free_, other.free_);
+    std::swap(size_, other.size_);
+    std::swap(compare_, other.compare_);
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index CompactBinarySearchTree<T, Compare>::FindIndex(const T& data) const {
+    Index temp = root_;
+    while (temp != kNull) {
+        const Node& node = nodes_[temp];
+        std::weak_ordering order = Order(data, node.value);
+
+        if (order < 0) {
+            temp = node.left;
+        } else if (order > 0) {
+            temp = node.right;
+        } else {
+            return temp;
+        }
+    }
+
+    return kNull;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::LowerBoundIndex(const T& key) const {
+
+    Index current = root_;
+    Index last = kNull;
+
+    while (current != kNull) {
+        if (Less(nodes_[current].value, key)) {
+            current = nodes_[current].right;
+        } else {
+            last = current;
+            current = nodes_[current].left;
+        }
+    }
+
+    return last;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::UpperBoundIndex(const T& key) const {
+
+    Index current = root_;
+    Index last = kNull;
+
+    while (current != kNull) {
+        if (!Less(key, nodes_[current].value)) {
+            current = nodes_[current].right;
+        } else {
+            last = current;
+            current = nodes_[current].left;
+        }
+    }
+
+    return last;
+}
+
+template <typename T, typename Compare>
+bool CompactBinarySearchTree<T, Compare>::Less(const T& lhs, const T& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, T, T>) {
+        return compare_(lhs, rhs) < 0;
+    } else {
+        return compare_(lhs, rhs);
+    }
+}
+
+// Same dispatch as BinarySearchTree::Order: one comparator call per node when the comparator or <=> allows it
+template <typename T, typename Compare>
+std::weak_ordering CompactBinarySearchTree<T, Compare>::Order(const T& lhs, const T& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, T, T>) {
+        return compare_(lhs, rhs);
+    } else if constexpr ((std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>) &&
+                         std::three_way_comparable<T, std::weak_ordering>) {
+        return lhs <=> rhs;
+    } else if (Less(lhs, rhs)) {
+        return std::weak_ordering::less;
+    } else if (Less(rhs, lhs)) {
+        return std::weak_ordering::greater;
+    } else {
+        return std::weak_ordering::equivalent;
+    }
+}
+
+template <typename T, typename Compare>
+size_t CompactBinarySearchTree<T, Compare>::count(const T& key) const {
+    Index upper = UpperBoundIndex(key);
+
+    size_t count = 0;
+    for (Index temp = LowerBoundIndex(key); temp != upper; temp = Next(temp, InOrderTag())) {
+        count += 1;
+    }
+
+    return count;
+}
+
+template <typename T, typename Compare>
+bool CompactBinarySearchTree<T, Compare>::operator==(const CompactBinarySearchTree& other) const {
+    if (size_ != other.size_) {
+        return false;
+    }
+
+    for (auto lhs = begin(pre), rhs = other.begin(pre); lhs != end(pre); ++lhs, ++rhs) {
+        if (Order(*lhs, *rhs) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index CompactBinarySearchTree<T, Compare>::First(InOrderTag) const {
+    return leftmost_;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index CompactBinarySearchTree<T, Compare>::First(PreOrderTag) const {
+    return root_;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index CompactBinarySearchTree<T, Compare>::First(PostOrderTag) const {
+    Index index = leftmost_;
+    while (index != kNull && (nodes_[index].left != kNull || nodes_[index].right != kNull)) {
+        index = (nodes_[index].left != kNull) ? nodes_[index].left : nodes_[index].right;
+    }
+
+    return index;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Next(Index index, InOrderTag) const {
+
+    if (nodes_[index].right != kNull) {
+        index = nodes_[index].right;
+        while (nodes_[index].left != kNull) {
+            index = nodes_[index].left;
+        }
+
+        return index;
+    }
+
+    while (nodes_[index].parent != kNull && index == nodes_[nodes_[index].parent].right) {
+        index = nodes_[index].parent;
+    }
+
+    return nodes_[index].parent;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Prev(Index index, InOrderTag) const {
+
+    if (index == kNull) {
+        return rightmost_;
+    }
+
+    if (nodes_[index].left != kNull) {
+        index = nodes_[index].left;
+        while (nodes_[index].right != kNull) {
+            index = nodes_[index].right;
+        }
+
+        return index;
+    }
+
+    while (nodes_[index].parent != kNull && index == nodes_[nodes_[index].parent].left) {
+        index = nodes_[index].parent;
+    }
+
+    return nodes_[index].parent;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Next(Index index, PreOrderTag) const {
+
+    if (nodes_[index].left != kNull) {
+        return nodes_[index].left;
+    }
+    if (nodes_[index].right != kNull) {
+        return nodes_[index].right;
+    }
+
+    while (nodes_[index].parent != kNull) {
+        const Node& parent = nodes_[nodes_[index].parent];
+        if (index != parent.right && parent.right != kNull) {
+            return parent.right;
+        }
+
+        index = nodes_[index].parent;
+    }
+
+    return kNull;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Prev(Index index, PreOrderTag) const {
+
+    Index last;
+    if (index == kNull) {
+        last = root_;
+    } else {
+        Index parent = nodes_[index].parent;
+        if (parent == kNull || index == nodes_[parent].left || nodes_[parent].left == kNull) {
+            return parent;
+        }
+
+        last = nodes_[parent].left;
+    }
+
+    while (last != kNull && (nodes_[last].left != kNull || nodes_[last].right != kNull)) {
+        last = (nodes_[last].right != kNull) ? nodes_[last].right : nodes_[last].left;
+    }
+
+    return last;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Next(Index index, PostOrderTag) const {
+
+    Index parent = nodes_[index].parent;
+    if (parent == kNull || index == nodes_[parent].right || nodes_[parent].right == kNull) {
+        return parent;
+    }
+
+    index = nodes_[parent].right;
+    while (nodes_[index].left != kNull || nodes_[index].right != kNull) {
+        index = (nodes_[index].left != kNull) ? nodes_[index].left : nodes_[index].right;
+    }
+
+    return index;
+}
+
+template <typename T, typename Compare>
+typename CompactBinarySearchTree<T, Compare>::Index
+    CompactBinarySearchTree<T, Compare>::Prev(Index index, PostOrderTag) const {
+
+    if (index == kNull) {
+        return root_;
+    }
+
+    if (nodes_[index].right != kNull) {
+        return nodes_[index].right;
+    }
+    if (nodes_[index].left != kNull) {
+        return nodes_[index].left;
+    }
+
+    while (nodes_[index].parent != kNull) {
+        const Node& parent = nodes_[nodes_[index].parent];
+        if (index != parent.left && parent.left != kNull) {
+            return parent.left;
+        }
+
+        index = nodes_[index].parent;
+    }
+
+    return kNull;
+}
@@ -0,0 +1,273 @@
+#pragma once
+
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <iterator>
+#include <algorithm>
+#include <functional>
+
+#include "BinarySearchTree.hpp"
+
+// Immutable snapshot of a sorted sequence in Eytzinger (breadth-first) order: the children of the node at
+// 1-based position k sit at 2k and 2k + 1. A search step is a comparison turned into an index, with no
+// data-dependent branch, and the first levels of every search share the same few cache lines.
+template <typename T, typename Compare = std::less<T>>
+class FrozenBinarySearchTree {
+ public:
+    class Iterator;
+
+    FrozenBinarySearchTree() : compare_{} {}
+    explicit FrozenBinarySearchTree(const Compare& comp) : compare_(comp) {}
+    template <std::input_iterator InputIt>
+    FrozenBinarySearchTree(InputIt first, InputIt last, const Compare& comp = Compare());
+
+    Compare key_comp() const { return compare_; }
+
+    Iterator begin() const { return Iterator(First(), this); }
+    Iterator end() const { return Iterator(0, this); }
+    Iterator cbegin() const { return begin(); }
+    Iterator cend() const { return end(); }
+    std::reverse_iterator<Iterator> rbegin() const { return std::reverse_iterator<Iterator>(end()); }
+    std::reverse_iterator<Iterator> rend() const { return std::reverse_iterator<Iterator>(begin()); }
+
+    [[nodiscard]] size_t size() const { return values_.size(); }
+    [[nodiscard]] bool empty() const { return values_.empty(); }
+
+    const T& front() const { return *begin(); }
+    const T& back() const { return *rbegin(); }
+
+    Iterator find(const T& key) const;
+    bool contains(const T& key) const { return find(key) != end(); }
+    size_t count(const T& key) const { return std::distance(lower_bound(key), upper_bound(key)); }
+    Iterator lower_bound(const T& key) const { return Iterator(LowerBound(key), this); }
+    Iterator upper_bound(const T& key) const { return Iterator(UpperBound(key), this); }
+
+    template <typename Tree = BinarySearchTree<T, Compare>>
+    Tree thaw() const { return Tree(begin(), end(), compare_); }
+
+ private:
+    // Prefetching the position this many levels ahead touches a whole cache line of descendants at once
+    static constexpr size_t kLookahead = std::bit_floor(std::max<size_t>(1, 64 / sizeof(T)));
+
+    void Prefetch(size_t position) const;
+    size_t LowerBound(const T& key) const;
+    size_t UpperBound(const T& key) const;
+    size_t First() const;
+    size_t Next(size_t position) const;
+    size_t Prev(size_t position) const;
+    void Order(std::vector<size_t>& ranks, size_t position, size_t& rank) const;
+    bool Less(const T& lhs, const T& rhs) const;
+
+    std::vector<T> values_;
+    Compare compare_;
+};
+
+// Positions are 1-based Eytzinger indices, 0 is the end iterator
+template <typename T, typename Compare>
+class FrozenBinarySearchTree<T, Compare>::Iterator {
+ public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using difference_type   = std::ptrdiff_t;
+    using value_type        = T;
+    using pointer           = const T*;
+    using reference         = const T&;
+
+    Iterator() : position_(0), tree_(nullptr) {}
+    Iterator(size_t position, const FrozenBinarySearchTree* tree) : position_(position), tree_(tree) {}
+
+    Iterator& operator++() {
+        position_ = tree_->Next(position_);
+
+        return *this;
+    }
+
+    Iterator operator++(int32_t) {
+        Iterator temp = *this;
+        ++(*this);
+
+        return temp;
+    }
+
+    Iterator& operator--() {
+        position_ = tree_->Prev(position_);
+
+        return *this;
+    }
+
+    Iterator operator--(int32_t) {
+        Iterator temp = *this;
+        --(*this);
+
+        return temp;
+    }
+
+    reference operator*() const {
+        return tree_->values_[position_ - 1];
+    }
+
+    pointer operator->() const {
+        return &tree_->values_[position_ - 1];
+    }
+
+    bool operator==(const Iterator& other) const {
+        return position_ == other.position_ && tree_ == other.tree_;
+    }
+
+    bool operator!=(const Iterator& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    size_t position_;
+    const FrozenBinarySearchTree* tree_;
+};
+
+template <typename T, typename Compare>
+template <std::input_iterator InputIt>
+FrozenBinarySearchTree<T, Compare>::FrozenBinarySearchTree(InputIt first, InputIt last, const Compare& comp)
+    : compare_(comp) {
+
+    std::vector<T> sorted(first, last);
+    auto less = [this](const T& lhs, const T& rhs) { return Less(lhs, rhs); };
+    if (!std::is_sorted(sorted.begin(), sorted.end(), less)) {
+        std::stable_sort(sorted.begin(), sorted.end(), less);
+    }
+
+    std::vector<size_t> ranks(sorted.size() + 1);
+    size_t rank = 0;
+    Order(ranks, 1, rank);
+
+    values_.reserve(sorted.size());
+    for (size_t position = 1; position <= sorted.size(); ++position) {
+        values_.push_back(std::move(sorted[ranks[position]]));
+    }
+}
+
+// Numbers the implicit tree in order, which is the sorted rank each position has to hold
+template <typename T, typename Compare>
+void FrozenBinarySearchTree<T, Compare>::Order(std::vector<size_t>& ranks, size_t position, size_t& rank) const {
+    if (position >= ranks.size()) {
+        return;
+    }
+
+    Order(ranks, 2 * position, rank);
+    ranks[position] = rank++;
+    Order(ranks, 2 * position + 1, rank);
+}
+
+template <typename T, typename Compare>
+bool FrozenBinarySearchTree<T, Compare>::Less(const T& lhs, const T& rhs) const {
+    if constexpr (ThreeWayCompare<Compare, T, T>) {
+        return compare_(lhs, rhs) < 0;
+    } else {
+        return compare_(lhs, rhs);
+    }
+}
+
+template <typename T, typename Compare>
+void FrozenBinarySearchTree<T, Compare>::Prefetch(size_t position) const {
+    // The address is only a hint and may lie past the end of the array, so it is formed as an integer
+    ::Prefetch(reinterpret_cast<const void*>(reinterpret_cast<uintptr_t>(values_.data()) +
+                                             (position * kLookahead - 1) * sizeof(T)));
+}
+
+// Descends to a leaf, then climbs past the trailing right turns: the last left turn is the answer
+template <typename T, typename Compare>
+size_t FrozenBinarySearchTree<T, Compare>::LowerBound(const T& key) const {
+    size_t position = 1;
+    while (position <= values_.size()) {
+        Prefetch(position);
+        position = 2 * position + static_cast<size_t>(Less(values_[position - 1], key));
+    }
+
+    return position >> (std::countr_one(position) + 1);
+}
+
+template <typename T, typename Compare>
+size_t FrozenBinarySearchTree<T, Compare>::UpperBound(const T& key) const {
+    size_t position = 1;
+    while (position <= values_.size()) {
+        Prefetch(position);
+        position = 2 * position + static_cast<size_t>(!Less(key, values_[position - 1]));
+    }
+
+    return position >> (std::countr_one(position) + 1);
+}
+
+template <typename T, typename Compare>
+typename FrozenBinarySearchTree<T, Compare>::Iterator FrozenBinarySearchTree<T, Compare>::find(const T& key) const {
+    size_t position = LowerBound(key);
+    if (position == 0 || Less(key, values_[position - 1])) {
+        return end();
+    }
+
+    return Iterator(position, this);
+}
+
+template <typename T, typename Compare>
+size_t FrozenBinarySearchTree<T, Compare>::First() const {
+    if (values_.empty()) {
+        return 0;
+    }
+
+    size_t position = 1;
+    while (2 * position <= values_.size()) {
+        position = 2 * position;
+    }
+
+    return position;
+}
+
+template <typename T, typename Compare>
+size_t FrozenBinarySearchTree<T, Compare>::Next(size_t position) const {
+    if (2 * position + 1 <= values_.size()) {
+        position = 2 * position + 1;
+        while (2 * position <= values_.size()) {
+            position = 2 * position;
+        }
+
+        return position;
+    }
+
+    return position >> (std::countr_one(position) + 1);
+}
+
+template <typename T, typename Compare>
+size_t FrozenBinarySearchTree<T, Compare>::Prev(size_t position) const {
+    if (position == 0) {
+        if (values_.empty()) {
+            return 0;
+        }
+
+        position = 1;
+        while (2 * position + 1 <= values_.size()) {
+            position = 2 * position + 1;
+        }
+
+        return position;
+    }
+
+    if (2 * position <= values_.size()) {
+        position = 2 * position;
+        while (2 * position + 1 <= values_.size()) {
+            position = 2 * position + 1;
+        }
+
+        return position;
+    }
+
+    return position >> (std::countr_zero(position) + 1);
+}
+
+template<typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
+FrozenBinarySearchTree<T, Compare> BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::freeze() const {
+    std::vector<T> values;
+    values.reserve(size_);
+    for (auto it = cbegin(in); it != cend(in); ++it) {
+        values.push_back(*it);
+    }
+
+    return FrozenBinarySearchTree<T, Compare>(std::make_move_iterator(values.begin()),
+                                              std::make_move_iterator(values.end()), compare_);
+}
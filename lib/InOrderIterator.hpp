@@ -1,8 +1,8 @@
 #include "BinarySearchTree.hpp"
 
-template <typename T, typename Compare, typename Allocator>
+template <typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
 template <bool IsConst>
-class BinarySearchTree<T, Compare, Allocator>::InOrderIterator {
+class BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::InOrderIterator {
  public:
     using size_type	                     = size_t;
     using node_type                      = Node;
@@ -13,17 +13,15 @@ class BinarySearchTree<T, Compare, Allocator>::InOrderIterator {
     using reference                      = node_type&;
     using conditional_pointer            = std::conditional_t<IsConst, const pointer, pointer>;
     using conditional_reference          = std::conditional_t<IsConst, const T&, T&>;
-    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree<T>*, BinarySearchTree<T>*>;
+    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree*, BinarySearchTree*>;
 
     InOrderIterator() = delete;
     InOrderIterator(conditional_pointer ptr, conditional_binary_search_tree bst) :
         ptr_(ptr), bst_(bst) {}
-    explicit InOrderIterator(BinarySearchTree<T, std::less<T>, std::allocator<T>>::Node* in_order_iterator) :
+    explicit InOrderIterator(Node* in_order_iterator) :
                 ptr_(in_order_iterator) {}
-    InOrderIterator(const InOrderIterator& in_order_iterator) {
-        this->ptr_ = in_order_iterator.ptr_;
-        this->bst_ = in_order_iterator.bst_;
-    };
+    InOrderIterator(const InOrderIterator&) = default;
+    InOrderIterator& operator=(const InOrderIterator&) = default;
 
     InOrderIterator operator++(int32_t) {
         InOrderIterator temp = *this;
@@ -59,12 +57,7 @@ class BinarySearchTree<T, Compare, Allocator>::InOrderIterator {
 
     InOrderIterator& operator--() {
         if (this->ptr_ == nullptr) {
-            Node* temp = this->bst_->root_;
-            while (temp && temp->right) {
-                temp = temp->right;
-            }
-
-            this->ptr_ = temp;
+            this->ptr_ = this->bst_->rightmost_;
 
             return *this;
         }
@@ -94,6 +87,10 @@ class BinarySearchTree<T, Compare, Allocator>::InOrderIterator {
     }
 
     bool operator<(const InOrderIterator& in_order_iterator) const {
+        if constexpr (IsOrderStatistic) {
+            return bst_->Index(ptr_) < bst_->Index(in_order_iterator.ptr_);
+        }
+
         auto temp = *this;
         while (temp != this->bst_->end(in) &&
                temp != in_order_iterator) {
@@ -130,6 +127,10 @@ class BinarySearchTree<T, Compare, Allocator>::InOrderIterator {
     }
 
     difference_type operator-(const InOrderIterator& other) const {
+        if constexpr (IsOrderStatistic) {
+            return static_cast<difference_type>(bst_->Index(ptr_)) - static_cast<difference_type>(bst_->Index(other.ptr_));
+        }
+
         auto temp = *this;
         difference_type cnt = 0;
 
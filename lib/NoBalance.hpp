@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+// Default balancing policy: the tree keeps the shape given by the insertion order
+struct NoBalance {
+    struct NodeBase {};
+
+    // Whether joins keep the height logarithmic, which the join-based set operations rely on
+    static constexpr bool kBalanced = false;
+
+    template <typename Tree, typename Node>
+    static void AfterInsert(Tree&, Node*) {}
+
+    template <typename Tree, typename Node>
+    static void AfterErase(Tree&, Node*, Node*, Node*) {}
+
+    template <typename Tree, typename Node>
+    static void AfterAccess(Tree&, Node*) {}
+
+    template <typename Node>
+    static void AfterBuild(Node*, size_t, size_t) {}
+
+    // Links middle between two detached subtrees whose keys lie on either side of it; tree.root_ becomes the result
+    template <typename Tree, typename Node>
+    static void Join(Tree& tree, Node* left, Node* middle, Node* right) {
+        tree.LinkSubtrees(middle, left, right, nullptr, false);
+    }
+};
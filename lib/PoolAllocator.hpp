@@ -0,0 +1,147 @@
+#pragma once
+
+#include <new>
+#include <array>
+#include <memory>
+#include <algorithm>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+const size_t kDefaultChunkSize = 64 * 1024;
+
+// Hands out single objects from chunk-sized blocks and recycles freed ones through per-size free lists.
+// Not thread-safe: a resource is meant to be owned by one container (and its copies) at a time.
+class PoolResource {
+ public:
+    explicit PoolResource(size_t chunk_size = kDefaultChunkSize) :
+        chunk_size_(chunk_size), current_(nullptr), end_(nullptr) {
+        free_lists_.fill(nullptr);
+    }
+
+    PoolResource(const PoolResource&) = delete;
+    PoolResource& operator=(const PoolResource&) = delete;
+
+    ~PoolResource() {
+        for (std::byte* chunk : chunks_) {
+            ::operator delete(chunk);
+        }
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        if (!IsPooled(bytes, alignment)) {
+            return ::operator new(bytes, std::align_val_t(alignment));
+        }
+
+        size_t size_class = SizeClass(bytes);
+        if (free_lists_[size_class] != nullptr) {
+            FreeSlot* slot = free_lists_[size_class];
+            free_lists_[size_class] = slot->next;
+
+            return slot;
+        }
+
+        size_t slot_size = (size_class + 1) * kSlotAlignment;
+        if (current_ == nullptr || static_cast<size_t>(end_ - current_) < slot_size) {
+            NewChunk(slot_size);
+        }
+
+        void* result = current_;
+        current_ += slot_size;
+
+        return result;
+    }
+
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) {
+        if (!IsPooled(bytes, alignment)) {
+            ::operator delete(ptr, std::align_val_t(alignment));
+
+            return;
+        }
+
+        size_t size_class = SizeClass(bytes);
+        auto* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = free_lists_[size_class];
+        free_lists_[size_class] = slot;
+    }
+
+    [[nodiscard]] size_t ChunkCount() const {
+        return chunks_.size();
+    }
+
+ private:
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static constexpr size_t kSlotAlignment = alignof(std::max_align_t);
+    static constexpr size_t kSizeClasses = 32;
+
+    static size_t SizeClass(size_t bytes) {
+        return (bytes == 0) ? 0 : (bytes - 1) / kSlotAlignment;
+    }
+
+    static bool IsPooled(size_t bytes, size_t alignment) {
+        return alignment <= kSlotAlignment && SizeClass(bytes) < kSizeClasses;
+    }
+
+    void NewChunk(size_t slot_size) {
+        size_t chunk_size = std::max(chunk_size_, slot_size);
+        auto* chunk = static_cast<std::byte*>(::operator new(chunk_size));
+        chunks_.push_back(chunk);
+
+        current_ = chunk;
+        end_ = chunk + chunk_size;
+    }
+
+    size_t chunk_size_;
+    std::byte* current_;
+    std::byte* end_;
+    std::vector<std::byte*> chunks_;
+    std::array<FreeSlot*, kSizeClasses> free_lists_;
+};
+
+// Allocator over a shared PoolResource. Rebound copies share the resource, so the tree's
+// NodeAllocator and get_allocator() draw from the same pool.
+template <typename T>
+class PoolAllocator {
+ public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    PoolAllocator() : resource_(std::make_shared<PoolResource>()) {}
+    explicit PoolAllocator(size_t chunk_size) : resource_(std::make_shared<PoolResource>(chunk_size)) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept : resource_(other.resource_) {}
+
+    T* allocate(size_t count) {
+        return static_cast<T*>(resource_->Allocate(count * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t count) {
+        resource_->Deallocate(ptr, count * sizeof(T), alignof(T));
+    }
+
+    [[nodiscard]] const PoolResource& resource() const {
+        return *resource_;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const {
+        return resource_ == other.resource_;
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const {
+        return !(*this == other);
+    }
+
+ private:
+    template <typename U>
+    friend class PoolAllocator;
+
+    std::shared_ptr<PoolResource> resource_;
+};
@@ -1,9 +1,9 @@
 #include "BinarySearchTree.hpp"
 #include <stack>
 
-template <typename T, typename Compare, typename Allocator>
+template <typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
 template <bool IsConst>
-class BinarySearchTree<T, Compare, Allocator>::PostOrderIterator {
+class BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PostOrderIterator {
  public:
 
     using size_type	                     = size_t;
@@ -17,17 +17,15 @@ class BinarySearchTree<T, Compare, Allocator>::PostOrderIterator {
     using reference                      = node_type&;
     using conditional_pointer            = std::conditional_t<IsConst, const pointer, pointer>;
     using conditional_reference          = std::conditional_t<IsConst, const T&, T&>;
-    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree<T>*, BinarySearchTree<T>*>;
+    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree*, BinarySearchTree*>;
 
     PostOrderIterator() = delete;
     PostOrderIterator(conditional_pointer ptr, conditional_binary_search_tree bst) :
         ptr_(ptr), bst_(bst) {}
-    explicit PostOrderIterator(BinarySearchTree<T, std::less<T>, std::allocator<T>>::Node* post_order_iterator) :
+    explicit PostOrderIterator(Node* post_order_iterator) :
         ptr_(post_order_iterator) {}
-    PostOrderIterator(const PostOrderIterator& post_order_iterator) {
-        this->ptr_ = post_order_iterator.ptr_;
-        this->bst_ = post_order_iterator.bst_;
-    };
+    PostOrderIterator(const PostOrderIterator&) = default;
+    PostOrderIterator& operator=(const PostOrderIterator&) = default;
 
     PostOrderIterator operator++(int32_t) {
         PostOrderIterator temp = *this;
@@ -82,16 +80,11 @@ class BinarySearchTree<T, Compare, Allocator>::PostOrderIterator {
         } else if (ptr_->left != nullptr) {
             ptr_ = ptr_->left;
         } else {
-            while (ptr_->parent->left == ptr_) {
+            while (ptr_->parent != nullptr && (ptr_ == ptr_->parent->left || ptr_->parent->left == nullptr)) {
                 ptr_ = ptr_->parent;
             }
-            while (ptr_->parent == nullptr || ptr_->parent->right == ptr_) {
-                ptr_ = ptr_->parent;
-                if (ptr_->parent == nullptr || ptr_->parent->left != nullptr) {
-                    ptr_ = ptr_->left;
-                    break;
-                }
-            }
+
+            ptr_ = (ptr_->parent != nullptr) ? ptr_->parent->left : nullptr;
         }
 
         return *this;
@@ -1,8 +1,8 @@
 #include "BinarySearchTree.hpp"
 
-template <typename T, typename Compare, typename Allocator>
+template <typename T, typename Compare, typename Allocator, typename BalancePolicy, bool IsOrderStatistic>
 template <bool IsConst>
-class BinarySearchTree<T, Compare, Allocator>::PreOrderIterator {
+class BinarySearchTree<T, Compare, Allocator, BalancePolicy, IsOrderStatistic>::PreOrderIterator {
  public:
 
     using size_type	                     = size_t;
@@ -16,17 +16,15 @@ class BinarySearchTree<T, Compare, Allocator>::PreOrderIterator {
     using reference                      = node_type&;
     using conditional_pointer            = std::conditional_t<IsConst, const pointer, pointer>;
     using conditional_reference          = std::conditional_t<IsConst, const T&, T&>;
-    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree<T>*, BinarySearchTree<T>*>;
+    using conditional_binary_search_tree = std::conditional_t<IsConst, const BinarySearchTree*, BinarySearchTree*>;
 
     PreOrderIterator() = delete;
     PreOrderIterator(conditional_pointer ptr, conditional_binary_search_tree bst) :
         ptr_(ptr), bst_(bst) {}
-    explicit PreOrderIterator(BinarySearchTree<T, std::less<T>, std::allocator<T>>::Node* pre_order_iterator) :
+    explicit PreOrderIterator(Node* pre_order_iterator) :
         ptr_(pre_order_iterator) {}
-    PreOrderIterator(const PreOrderIterator& pre_order_iterator) {
-        this->ptr_ = pre_order_iterator.ptr_;
-        this->bst_ = pre_order_iterator.bst_;
-    };
+    PreOrderIterator(const PreOrderIterator&) = default;
+    PreOrderIterator& operator=(const PreOrderIterator&) = default;
 
     PreOrderIterator operator++(int32_t) {
         PreOrderIterator temp = *this;
@@ -36,32 +34,16 @@ class BinarySearchTree<T, Compare, Allocator>::PreOrderIterator {
     }
 
     PreOrderIterator& operator++() {
-        Node* max = this->bst_->root_;
-        while (max->right != nullptr) {
-            max = max->right;
-        }
-
-        if (max == ptr_) {
-            ptr_ = nullptr;
-
-            return *this;
-        }
-
         if (ptr_->left != nullptr) {
             ptr_ = ptr_->left;
         } else if (ptr_->right != nullptr) {
             ptr_ = ptr_->right;
         } else {
-            while (ptr_->parent->right == ptr_) {
-                ptr_ = ptr_->parent;
-            }
-            while (ptr_->parent == nullptr || ptr_->parent->left == ptr_) {
+            while (ptr_->parent != nullptr && (ptr_ == ptr_->parent->right || ptr_->parent->right == nullptr)) {
                 ptr_ = ptr_->parent;
-                if (ptr_->parent == nullptr || ptr_->parent->right != nullptr) {
-                    ptr_ = ptr_->right;
-                    break;
-                }
             }
+
+            ptr_ = (ptr_->parent != nullptr) ? ptr_->parent->right : nullptr;
         }
 
         return *this;
@@ -75,32 +57,27 @@ class BinarySearchTree<T, Compare, Allocator>::PreOrderIterator {
     }
 
     PreOrderIterator& operator--() {
-        if (ptr_ == nullptr) {
-            Node* max = bst_->root_;
-            while (max->right) {
-                max = max->right;
-            }
+        pointer node = nullptr;
 
-            ptr_ = max;
+        if (ptr_ == nullptr) {
+            node = bst_->rightmost_;
+        } else if (ptr_ == ptr_->parent->right && ptr_->parent->left) {
+            node = ptr_->parent->left;
+        } else {
+            ptr_ = ptr_->parent;
 
             return *this;
         }
 
-        if (ptr_ == ptr_->parent->right && ptr_->parent->left) {
-            pointer node = ptr_->parent->left;
-
-            while (node) {
-                ptr_ = node;
-                if (node->right) {
-                    node = node->right;
-                } else if (node->left) {
-                    node = node->left;
-                } else {
-                    break;
-                }
+        while (node) {
+            ptr_ = node;
+            if (node->right) {
+                node = node->right;
+            } else if (node->left) {
+                node = node->left;
+            } else {
+                break;
             }
-        } else {
-            ptr_ = ptr_->parent;
         }
 
         return *this;
@@ -117,7 +94,7 @@ class BinarySearchTree<T, Compare, Allocator>::PreOrderIterator {
         auto temp = *this;
         while (temp != this->bst_->end(pre) &&
             temp != pre_order_iterator) {
-            std::cout << *temp << " ";
+
             ++temp;
         }
 
@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+
+// Red-black balancing policy: keeps the height of the tree within 2 * log2(n + 1)
+struct RedBlackBalance {
+    struct NodeBase {
+        bool is_red = true;
+    };
+
+    static constexpr bool kBalanced = true;
+
+    template <typename Tree, typename Node>
+    static void AfterInsert(Tree& tree, Node* node) {
+        while (node != tree.root_ && node->parent->is_red) {
+            Node* parent = node->parent;
+            Node* grandparent = parent->parent;
+
+            if (parent == grandparent->left) {
+                Node* uncle = grandparent->right;
+
+                if (uncle && uncle->is_red) {
+                    parent->is_red = false;
+                    uncle->is_red = false;
+                    grandparent->is_red = true;
+                    node = grandparent;
+                } else {
+                    if (node == parent->right) {
+                        node = parent;
+                        tree.RotateLeft(node);
+                        parent = node->parent;
+                    }
+
+                    parent->is_red = false;
+                    grandparent->is_red = true;
+                    tree.RotateRight(grandparent);
+                }
+            } else {
+                Node* uncle = grandparent->left;
+
+                if (uncle && uncle->is_red) {
+                    parent->is_red = false;
+                    uncle->is_red = false;
+                    grandparent->is_red = true;
+                    node = grandparent;
+                } else {
+                    if (node == parent->left) {
+                        node = parent;
+                        tree.RotateRight(node);
+                        parent = node->parent;
+                    }
+
+                    parent->is_red = false;
+                    grandparent->is_red = true;
+                    tree.RotateLeft(grandparent);
+                }
+            }
+        }
+
+        tree.root_->is_red = false;
+    }
+
+    // removed has already been replaced by child (possibly nullptr) under parent
+    template <typename Tree, typename Node>
+    static void AfterErase(Tree& tree, Node* removed, Node* child, Node* parent) {
+        if (removed->is_red) {
+            return;
+        }
+
+        while (child != tree.root_ && (child == nullptr || !child->is_red)) {
+            if (child == parent->left) {
+                Node* sibling = parent->right;
+
+                if (sibling->is_red) {
+                    sibling->is_red = false;
+                    parent->is_red = true;
+                    tree.RotateLeft(parent);
+                    sibling = parent->right;
+                }
+
+                if (!IsRed(sibling->left) && !IsRed(sibling->right)) {
+                    sibling->is_red = true;
+                    child = parent;
+                    parent = parent->parent;
+                } else {
+                    if (!IsRed(sibling->right)) {
+                        sibling->left->is_red = false;
+                        sibling->is_red = true;
+                        tree.RotateRight(sibling);
+                        sibling = parent->right;
+                    }
+
+                    sibling->is_red = parent->is_red;
+                    parent->is_red = false;
+                    sibling->right->is_red = false;
+                    tree.RotateLeft(parent);
+                    child = tree.root_;
+                }
+            } else {
+                Node* sibling = parent->left;
+
+                if (sibling->is_red) {
+                    sibling->is_red = false;
+                    parent->is_red = true;
+                    tree.RotateRight(parent);
+                    sibling = parent->left;
+                }
+
+                if (!IsRed(sibling->left) && !IsRed(sibling->right)) {
+                    sibling->is_red = true;
+                    child = parent;
+                    parent = parent->parent;
+                } else {
+                    if (!IsRed(sibling->left)) {
+                        sibling->right->is_red = false;
+                        sibling->is_red = true;
+                        tree.RotateLeft(sibling);
+                        sibling = parent->left;
+                    }
+
+                    sibling->is_red = parent->is_red;
+                    parent->is_red = false;
+                    sibling->left->is_red = false;
+                    tree.RotateRight(parent);
+                    child = tree.root_;
+                }
+            }
+        }
+
+        if (child) {
+            child->is_red = false;
+        }
+    }
+
+    template <typename Tree, typename Node>
+    static void AfterAccess(Tree&, Node*) {}
+
+    // Bulk-built trees have all their leaves on the last two levels: only the last level is red
+    template <typename Node>
+    static void AfterBuild(Node* node, size_t depth, size_t height) {
+        node->is_red = (depth > 0 && depth + 1 == height);
+    }
+
+    // Both roots are made black, then a red middle goes on the spine of the taller subtree at the first black node
+    // with the black height of the other one, and the insertion fix-up repairs a red parent. Black heights are
+    // not stored, so measuring them costs a walk down each subtree.
+    template <typename Tree, typename Node>
+    static void Join(Tree& tree, Node* left, Node* middle, Node* right) {
+        if (left) {
+            left->is_red = false;
+        }
+        if (right) {
+            right->is_red = false;
+        }
+
+        size_t left_height = BlackHeight(left);
+        size_t right_height = BlackHeight(right);
+
+        if (left_height == right_height) {
+            tree.LinkSubtrees(middle, left, right, nullptr, false);
+            middle->is_red = false;
+
+            return;
+        }
+
+        if (left_height > right_height) {
+            Node* parent = nullptr;
+            Node* node = left;
+            while (left_height > right_height || IsRed(node)) {
+                left_height -= IsRed(node) ? 0 : 1;
+                parent = node;
+                node = node->right;
+            }
+
+            tree.LinkSubtrees(middle, node, right, parent, false);
+        } else {
+            Node* parent = nullptr;
+            Node* node = right;
+            while (right_height > left_height || IsRed(node)) {
+                right_height -= IsRed(node) ? 0 : 1;
+                parent = node;
+                node = node->left;
+            }
+
+            tree.LinkSubtrees(middle, left, node, parent, true);
+        }
+
+        middle->is_red = true;
+        AfterInsert(tree, middle);
+    }
+
+ private:
+    template <typename Node>
+    static bool IsRed(const Node* node) {
+        return node != nullptr && node->is_red;
+    }
+
+    template <typename Node>
+    static size_t BlackHeight(const Node* node) {
+        size_t height = 0;
+        for (; node != nullptr; node = node->left) {
+            height += IsRed(node) ? 0 : 1;
+        }
+
+        return height;
+    }
+};
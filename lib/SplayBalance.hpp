@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+
+// Splay balancing policy: every inserted or found node is moved to the root, so hot keys stay near the top
+struct SplayBalance {
+    struct NodeBase {};
+
+    static constexpr bool kBalanced = false;
+
+    template <typename Tree, typename Node>
+    static void AfterInsert(Tree& tree, Node* node) {
+        Splay(tree, node);
+    }
+
+    template <typename Tree, typename Node>
+    static void AfterErase(Tree& tree, Node*, Node*, Node* parent) {
+        if (parent != nullptr) {
+            Splay(tree, parent);
+        }
+    }
+
+    template <typename Tree, typename Node>
+    static void AfterAccess(Tree& tree, Node* node) {
+        Splay(tree, node);
+    }
+
+    template <typename Node>
+    static void AfterBuild(Node*, size_t, size_t) {}
+
+    template <typename Tree, typename Node>
+    static void Join(Tree& tree, Node* left, Node* middle, Node* right) {
+        tree.LinkSubtrees(middle, left, right, nullptr, false);
+    }
+
+ private:
+    template <typename Tree, typename Node>
+    static void Rotate(Tree& tree, Node* node) {
+        if (node == node->parent->left) {
+            tree.RotateRight(node->parent);
+        } else {
+            tree.RotateLeft(node->parent);
+        }
+    }
+
+    template <typename Tree, typename Node>
+    static void Splay(Tree& tree, Node* node) {
+        while (node->parent != nullptr) {
+            Node* parent = node->parent;
+            Node* grandparent = parent->parent;
+
+            if (grandparent == nullptr) {
+                Rotate(tree, node);
+            } else if ((node == parent->left) == (parent == grandparent->left)) {
+                Rotate(tree, parent);
+                Rotate(tree, node);
+            } else {
+                Rotate(tree, node);
+                Rotate(tree, node);
+            }
+        }
+    }
+};
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Treap balancing policy: nodes keep a random priority in heap order, so the expected height is O(log n)
+struct TreapBalance {
+    struct NodeBase {
+        uint32_t priority = NextPriority();
+    };
+
+    static constexpr bool kBalanced = true;
+
+    template <typename Tree, typename Node>
+    static void AfterInsert(Tree& tree, Node* node) {
+        while (node->parent != nullptr && node->parent->priority < node->priority) {
+            if (node == node->parent->left) {
+                tree.RotateRight(node->parent);
+            } else {
+                tree.RotateLeft(node->parent);
+            }
+        }
+    }
+
+    // Splicing out a node with at most one child keeps the heap order
+    template <typename Tree, typename Node>
+    static void AfterErase(Tree&, Node*, Node*, Node*) {}
+
+    template <typename Tree, typename Node>
+    static void AfterAccess(Tree&, Node*) {}
+
+    // Raising a node to the largest priority below it keeps the heap order of a bulk-built tree
+    template <typename Node>
+    static void AfterBuild(Node* node, size_t, size_t) {
+        if (node->left && node->left->priority > node->priority) {
+            node->priority = node->left->priority;
+        }
+        if (node->right && node->right->priority > node->priority) {
+            node->priority = node->right->priority;
+        }
+    }
+
+    // Puts middle on top of both subtrees, then rotates it down until the heap order holds again
+    template <typename Tree, typename Node>
+    static void Join(Tree& tree, Node* left, Node* middle, Node* right) {
+        tree.LinkSubtrees(middle, left, right, nullptr, false);
+
+        while (true) {
+            Node* child = middle->left;
+            if (middle->right && (child == nullptr || middle->right->priority > child->priority)) {
+                child = middle->right;
+            }
+
+            if (child == nullptr || child->priority <= middle->priority) {
+                return;
+            }
+
+            if (child == middle->left) {
+                tree.RotateRight(middle);
+            } else {
+                tree.RotateLeft(middle);
+            }
+        }
+    }
+
+ private:
+    static uint32_t NextPriority() {
+        thread_local uint32_t state = 2463534242u;
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        return state;
+    }
+};
@@ -4,7 +4,23 @@
 #include "../lib/InOrderIterator.hpp"
 #include "../lib/PreOrderIterator.hpp"
 #include "../lib/PostOrderIterator.hpp"
-
+#include "../lib/RedBlackBalance.hpp"
+#include "../lib/AvlBalance.hpp"
+#include "../lib/TreapBalance.hpp"
+#include "../lib/SplayBalance.hpp"
+#include "../lib/PoolAllocator.hpp"
+#include "../lib/ArenaAllocator.hpp"
+#include "../lib/CompactBinarySearchTree.hpp"
+#include "../lib/FrozenBinarySearchTree.hpp"
+#include "../lib/BPlusTree.hpp"
+
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <memory_resource>
 
 
 TEST(InOrderIteratorTestSuite, ForwardIterator) {
@@ -884,11 +900,1866 @@ TEST(BinarySearchTreeTestSuite, OtherMethods) {
 
     ASSERT_TRUE(bst == bst_2);
 
-    ASSERT_TRUE(bst.extract(15) == 15);
+    ASSERT_TRUE(bst.extract(15).value() == 15);
 
     ASSERT_TRUE(bst != bst_2);
 
-    ASSERT_TRUE(bst_2.extract(15) == 15);
+    ASSERT_TRUE(bst_2.extract(15).value() == 15);
 
     ASSERT_TRUE(bst == bst_2);
 }
+
+TEST(BinarySearchTreeTestSuite, SizeTracking) {
+    BinarySearchTree<int32_t> bst;
+
+    ASSERT_TRUE(bst.empty());
+    ASSERT_EQ(bst.size(), 0);
+
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i % 10);
+    }
+
+    ASSERT_EQ(bst.size(), 100);
+
+    bst.erase(5);
+    bst.erase(100);
+    ASSERT_EQ(bst.size(), 99);
+
+    bst.extract(3);
+    ASSERT_EQ(bst.size(), 98);
+
+    BinarySearchTree<int32_t> copy = bst;
+    ASSERT_EQ(copy.size(), 98);
+
+    BinarySearchTree<int32_t> other;
+    other.insert(1);
+    other = bst;
+    ASSERT_EQ(other.size(), 98);
+    ASSERT_TRUE(other == bst);
+
+    bst.clear();
+    ASSERT_TRUE(bst.empty());
+    ASSERT_EQ(bst.size(), 0);
+
+    bst.swap(copy);
+    ASSERT_EQ(bst.size(), 98);
+    ASSERT_TRUE(copy.empty());
+}
+
+TEST(BinarySearchTreeTestSuite, CachedBoundaries) {
+    BinarySearchTree<int32_t> bst;
+
+    ASSERT_TRUE(bst.begin() == bst.end());
+
+    std::vector<int32_t> values = {25, 15, 10, 4, 12, 22, 18, 24, 50, 35, 31, 44, 70, 66, 90};
+    for (int32_t value : values) {
+        bst.insert(value);
+    }
+
+    std::sort(values.begin(), values.end());
+
+    while (!bst.empty()) {
+        ASSERT_EQ(bst.front(), values.front());
+        ASSERT_EQ(bst.back(), values.back());
+        ASSERT_EQ(*(--bst.end()), values.back());
+        ASSERT_EQ(*bst.cbegin(), values.front());
+
+        if (values.size() % 2 == 0) {
+            bst.erase(values.front());
+            values.erase(values.begin());
+        } else {
+            bst.erase(values.back());
+            values.pop_back();
+        }
+    }
+
+    ASSERT_TRUE(bst.begin() == bst.end());
+}
+
+using RedBlackTree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance>;
+
+bool IsValidRedBlackTree(RedBlackTree& bst) {
+    int32_t black_height = -1;
+
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        auto node = it.Get();
+
+        if (node->is_red && node->parent && node->parent->is_red) {
+            return false;
+        }
+        if (node->left && node->left->parent != node) {
+            return false;
+        }
+        if (node->right && node->right->parent != node) {
+            return false;
+        }
+
+        if (node->left == nullptr || node->right == nullptr) {
+            int32_t blacks = 0;
+            for (auto temp = node; temp != nullptr; temp = temp->parent) {
+                blacks += temp->is_red ? 0 : 1;
+            }
+
+            if (black_height != -1 && black_height != blacks) {
+                return false;
+            }
+            black_height = blacks;
+        }
+    }
+
+    return bst.empty() || !bst.begin(pre).Get()->is_red;
+}
+
+template <typename Tree>
+size_t Height(Tree& bst) {
+    size_t height = 0;
+
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        size_t depth = 0;
+        for (auto temp = it.Get(); temp != nullptr; temp = temp->parent) {
+            depth += 1;
+        }
+
+        height = std::max(height, depth);
+    }
+
+    return height;
+}
+
+TEST(RedBlackBalanceTestSuite, SortedInsert) {
+    RedBlackTree bst;
+
+    for (int32_t i = 0; i < 1024; ++i) {
+        bst.insert(i);
+    }
+
+    ASSERT_TRUE(IsValidRedBlackTree(bst));
+    ASSERT_LE(Height(bst), 2 * std::log2(1024 + 1));
+
+    std::vector<int32_t> result(bst.begin(), bst.end());
+    std::vector<int32_t> predict(1024);
+    std::iota(predict.begin(), predict.end(), 0);
+
+    ASSERT_EQ(result, predict);
+
+    std::vector<int32_t> reversed(bst.rbegin(), bst.rend());
+    std::reverse(predict.begin(), predict.end());
+
+    ASSERT_EQ(reversed, predict);
+}
+
+TEST(RedBlackBalanceTestSuite, EraseAndExtract) {
+    RedBlackTree bst;
+
+    for (int32_t i = 1024; i > 0; --i) {
+        bst.insert(i);
+    }
+
+    for (int32_t i = 2; i <= 1024; i += 2) {
+        bst.erase(i);
+        ASSERT_TRUE(IsValidRedBlackTree(bst));
+    }
+
+    for (int32_t i = 1; i <= 512; i += 2) {
+        ASSERT_EQ(bst.extract(i).value(), i);
+        ASSERT_TRUE(IsValidRedBlackTree(bst));
+    }
+
+    ASSERT_EQ(bst.size(), 256);
+    ASSERT_LE(Height(bst), 2 * std::log2(256 + 1));
+    ASSERT_EQ(bst.front(), 513);
+    ASSERT_EQ(bst.back(), 1023);
+
+    RedBlackTree copy = bst;
+    ASSERT_TRUE(copy == bst);
+    ASSERT_TRUE(IsValidRedBlackTree(copy));
+
+    for (int32_t i = 513; i <= 1023; i += 2) {
+        bst.erase(i);
+        ASSERT_TRUE(IsValidRedBlackTree(bst));
+    }
+
+    ASSERT_TRUE(bst.empty());
+}
+
+using AvlTree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, AvlBalance>;
+using Treap = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, TreapBalance>;
+using SplayTree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, SplayBalance>;
+using OrderStatisticTree = BinarySearchTree<int32_t, std::less<int32_t>, std::allocator<int32_t>, RedBlackBalance, true>;
+
+bool IsValidAvlTree(AvlTree& bst) {
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        auto node = it.Get();
+        int32_t left = node->left ? node->left->height : 0;
+        int32_t right = node->right ? node->right->height : 0;
+
+        if (node->height != 1 + std::max(left, right) || std::abs(left - right) > 1) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsValidTreap(Treap& bst) {
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        auto node = it.Get();
+
+        if (node->parent && node->parent->priority < node->priority) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool IsValidOrderStatisticTree(OrderStatisticTree& bst) {
+    for (auto it = bst.begin(); it != bst.end(); ++it) {
+        auto node = it.Get();
+        size_t left = node->left ? node->left->subtree_size : 0;
+        size_t right = node->right ? node->right->subtree_size : 0;
+
+        if (node->subtree_size != left + right + 1) {
+            return false;
+        }
+    }
+
+    return bst.empty() || bst.begin(pre).Get()->subtree_size == bst.size();
+}
+
+TEST(AvlBalanceTestSuite, InsertAndErase) {
+    AvlTree bst;
+
+    for (int32_t i = 0; i < 1024; ++i) {
+        bst.insert(i);
+    }
+
+    ASSERT_TRUE(IsValidAvlTree(bst));
+    ASSERT_EQ(Height(bst), 11);
+
+    for (int32_t i = 0; i < 1024; i += 3) {
+        bst.erase(i);
+        ASSERT_TRUE(IsValidAvlTree(bst));
+    }
+
+    std::vector<int32_t> result(bst.begin(), bst.end());
+    std::vector<int32_t> predict;
+    for (int32_t i = 0; i < 1024; ++i) {
+        if (i % 3 != 0) {
+            predict.push_back(i);
+        }
+    }
+
+    ASSERT_EQ(result, predict);
+}
+
+TEST(TreapBalanceTestSuite, InsertAndErase) {
+    Treap bst;
+
+    for (int32_t i = 0; i < 4096; ++i) {
+        bst.insert(i);
+    }
+
+    ASSERT_TRUE(IsValidTreap(bst));
+    ASSERT_LT(Height(bst), 64);
+
+    for (int32_t i = 0; i < 4096; i += 2) {
+        bst.erase(i);
+    }
+
+    ASSERT_TRUE(IsValidTreap(bst));
+    ASSERT_EQ(bst.size(), 2048);
+    ASSERT_EQ(bst.front(), 1);
+    ASSERT_EQ(bst.back(), 4095);
+}
+
+TEST(SplayBalanceTestSuite, AccessMovesToRoot) {
+    SplayTree bst;
+
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i);
+        ASSERT_EQ(*bst.begin(pre), i);
+    }
+
+    ASSERT_EQ(*bst.find(42), 42);
+    ASSERT_EQ(*bst.begin(pre), 42);
+    ASSERT_EQ(*bst.find(7, pre), 7);
+    ASSERT_EQ(*bst.begin(pre), 7);
+
+    bst.erase(7);
+    bst.erase(42);
+
+    std::vector<int32_t> result(bst.begin(), bst.end());
+    std::vector<int32_t> predict;
+    for (int32_t i = 0; i < 100; ++i) {
+        if (i != 7 && i != 42) {
+            predict.push_back(i);
+        }
+    }
+
+    ASSERT_EQ(result, predict);
+}
+
+TEST(OrderStatisticTestSuite, RankAndSelect) {
+    OrderStatisticTree bst;
+
+    for (int32_t i = 0; i < 1000; ++i) {
+        bst.insert(i * 2);
+    }
+
+    for (int32_t i = 0; i < 1000; i += 7) {
+        ASSERT_EQ(*bst.nth_element(i), i * 2);
+        ASSERT_EQ(bst.rank(i * 2), i);
+        ASSERT_EQ(bst.rank(i * 2 + 1), i + 1);
+    }
+
+    ASSERT_TRUE(bst.nth_element(1000) == bst.end());
+    ASSERT_EQ(bst.rank(-1), 0);
+    ASSERT_EQ(bst.rank(5000), 1000);
+
+    for (int32_t i = 0; i < 1000; i += 2) {
+        bst.erase(i * 2);
+    }
+
+    for (int32_t i = 0; i < 500; ++i) {
+        ASSERT_EQ(*bst.nth_element(i), i * 4 + 2);
+        ASSERT_EQ(bst.rank(i * 4 + 2), i);
+    }
+
+    ASSERT_TRUE(IsValidOrderStatisticTree(bst));
+}
+
+TEST(OrderStatisticTestSuite, IteratorDistance) {
+    OrderStatisticTree bst;
+
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i);
+    }
+
+    auto first = bst.find(10);
+    auto second = bst.find(73);
+
+    ASSERT_EQ(second - first, 63);
+    ASSERT_EQ(first - second, -63);
+    ASSERT_EQ(bst.end() - bst.begin(), 100);
+    ASSERT_EQ(std::distance(bst.begin(), bst.end()), 100);
+    ASSERT_TRUE(first < second);
+    ASSERT_TRUE(second < bst.end());
+    ASSERT_FALSE(second < first);
+    ASSERT_TRUE(second >= first);
+}
+
+TEST(BinarySearchTreeTestSuite, DuplicateKeys) {
+    BinarySearchTree<int32_t> bst;
+    OrderStatisticTree indexed;
+
+    for (int32_t i = 0; i < 300; ++i) {
+        bst.insert((i * 7) % 10);
+        indexed.insert((i * 7) % 10);
+    }
+
+    for (int32_t key = 0; key < 10; ++key) {
+        ASSERT_EQ(bst.count(key), 30);
+        ASSERT_EQ(indexed.count(key), 30);
+
+        auto [first, last] = bst.equal_range(key);
+        ASSERT_EQ(std::distance(first, last), 30);
+        ASSERT_TRUE(first == bst.lower_bound(key));
+        ASSERT_TRUE(last == bst.upper_bound(key));
+
+        auto [indexed_first, indexed_last] = indexed.equal_range(key);
+        ASSERT_EQ(indexed_last - indexed_first, 30);
+    }
+
+    ASSERT_EQ(bst.count(-1), 0);
+    ASSERT_EQ(indexed.count(10), 0);
+    ASSERT_TRUE(bst.equal_range(10).first == bst.end());
+    ASSERT_TRUE(indexed.equal_range(-1).first == indexed.begin());
+}
+
+TEST(PoolAllocatorTestSuite, RecyclesErasedNodes) {
+    using PooledTree = BinarySearchTree<int32_t, std::less<int32_t>, PoolAllocator<int32_t>, RedBlackBalance>;
+
+    PooledTree bst;
+
+    for (int32_t i = 0; i < 10000; ++i) {
+        bst.insert(i);
+    }
+
+    size_t chunks = bst.get_allocator().resource().ChunkCount();
+
+    for (int32_t round = 0; round < 10; ++round) {
+        for (int32_t i = round % 2; i < 10000; i += 2) {
+            bst.erase(i);
+        }
+        for (int32_t i = round % 2; i < 10000; i += 2) {
+            bst.insert(i);
+        }
+    }
+
+    ASSERT_EQ(bst.get_allocator().resource().ChunkCount(), chunks);
+    ASSERT_EQ(bst.size(), 10000);
+
+    std::vector<int32_t> result(bst.begin(), bst.end());
+    std::vector<int32_t> predict(10000);
+    std::iota(predict.begin(), predict.end(), 0);
+
+    ASSERT_EQ(result, predict);
+
+    PooledTree copy = bst;
+    ASSERT_TRUE(copy == bst);
+    ASSERT_TRUE(copy.get_allocator() == bst.get_allocator());
+}
+
+TEST(PoolAllocatorTestSuite, RebindSharesResource) {
+    PoolAllocator<int32_t> allocator;
+    PoolAllocator<double> rebound(allocator);
+
+    ASSERT_TRUE(rebound == allocator);
+    ASSERT_TRUE(PoolAllocator<int32_t>() != allocator);
+
+    double* first = rebound.allocate(1);
+    rebound.deallocate(first, 1);
+    double* second = rebound.allocate(1);
+
+    ASSERT_EQ(first, second);
+
+    rebound.deallocate(second, 1);
+}
+
+TEST(ArenaAllocatorTestSuite, ClearRewindsArena) {
+    using ArenaTree = BinarySearchTree<int32_t, std::less<int32_t>, ArenaAllocator<int32_t>, RedBlackBalance>;
+
+    ArenaTree bst;
+
+    for (int32_t i = 0; i < 100000; ++i) {
+        bst.insert(i);
+    }
+
+    size_t chunks = bst.get_allocator().arena().ChunkCount();
+    ASSERT_GT(bst.get_allocator().arena().BytesUsed(), 0);
+
+    bst.clear();
+
+    ASSERT_TRUE(bst.empty());
+    ASSERT_TRUE(bst.begin() == bst.end());
+    ASSERT_EQ(bst.get_allocator().arena().BytesUsed(), 0);
+
+    for (int32_t i = 100000; i > 0; --i) {
+        bst.insert(i);
+    }
+
+    ASSERT_EQ(bst.get_allocator().arena().ChunkCount(), chunks);
+    ASSERT_EQ(bst.front(), 1);
+    ASSERT_EQ(bst.back(), 100000);
+
+    ArenaTree copy = bst;
+    ASSERT_TRUE(copy == bst);
+    ASSERT_TRUE(copy.get_allocator() != bst.get_allocator());
+
+    bst.clear();
+    ASSERT_EQ(copy.size(), 100000);
+    ASSERT_EQ(copy.back(), 100000);
+}
+
+TEST(ArenaAllocatorTestSuite, PolymorphicAllocator) {
+    using PmrTree = BinarySearchTree<int32_t, std::less<int32_t>, std::pmr::polymorphic_allocator<int32_t>>;
+
+    std::pmr::monotonic_buffer_resource buffer;
+    PmrTree bst{std::pmr::polymorphic_allocator<int32_t>(&buffer)};
+
+    std::vector<int32_t> values = {25, 15, 10, 4, 12, 22, 18, 24, 50, 35, 31, 44, 70, 66, 90};
+    for (int32_t value : values) {
+        bst.insert(value);
+    }
+
+    bst.erase(15);
+    ASSERT_EQ(bst.size(), 14);
+    ASSERT_EQ(bst.get_allocator().resource(), &buffer);
+
+    PmrTree copy(bst, std::pmr::polymorphic_allocator<int32_t>(&buffer));
+    ASSERT_TRUE(copy == bst);
+
+    std::pmr::unsynchronized_pool_resource pool;
+    PmrTree pooled{std::pmr::polymorphic_allocator<int32_t>(&pool)};
+    for (int32_t value : values) {
+        pooled.insert(value);
+    }
+
+    pooled = bst;
+    ASSERT_TRUE(pooled == bst);
+    ASSERT_EQ(pooled.get_allocator().resource(), &pool);
+
+    bst.clear();
+    pooled.clear();
+    ASSERT_TRUE(bst.empty());
+    ASSERT_TRUE(pooled.empty());
+    ASSERT_EQ(copy.size(), 14);
+}
+
+TEST(BinarySearchTreeTestSuite, DegenerateTreeWithoutRecursion) {
+    SplayTree bst;
+
+    const int32_t kCount = 1'000'000;
+    for (int32_t i = 0; i < kCount; ++i) {
+        bst.insert(i);
+    }
+
+    size_t depth = 0;
+    for (auto node = bst.begin().Get(); node != nullptr; node = node->parent) {
+        depth += 1;
+    }
+
+    ASSERT_EQ(depth, kCount);
+
+    SplayTree copy = bst;
+    ASSERT_TRUE(copy == bst);
+    ASSERT_EQ(copy.front(), 0);
+    ASSERT_EQ(copy.back(), kCount - 1);
+
+    copy.erase(0);
+    ASSERT_EQ(copy.extract(1).value(), 1);
+    ASSERT_EQ(copy.size(), kCount - 2);
+    ASSERT_TRUE(copy != bst);
+
+    bst.clear();
+    ASSERT_TRUE(bst.empty());
+}
+
+TEST(BulkConstructionTestSuite, SortedRange) {
+    std::vector<int32_t> values(1000);
+    std::iota(values.begin(), values.end(), 0);
+
+    BinarySearchTree<int32_t> bst(values.begin(), values.end());
+    ASSERT_EQ(bst.size(), 1000);
+    ASSERT_EQ(Height(bst), 10);
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), values);
+    ASSERT_EQ(bst.front(), 0);
+    ASSERT_EQ(bst.back(), 999);
+
+    RedBlackTree red_black(values.begin(), values.end());
+    ASSERT_TRUE(IsValidRedBlackTree(red_black));
+    for (int32_t i = 0; i < 1000; i += 3) {
+        red_black.erase(i);
+        red_black.insert(i + 1000);
+    }
+    ASSERT_TRUE(IsValidRedBlackTree(red_black));
+
+    AvlTree avl(values.begin(), values.end());
+    ASSERT_TRUE(IsValidAvlTree(avl));
+
+    Treap treap(values.begin(), values.end());
+    ASSERT_TRUE(IsValidTreap(treap));
+
+    OrderStatisticTree indexed(values.begin(), values.end());
+    ASSERT_EQ(*indexed.nth_element(500), 500);
+    ASSERT_EQ(indexed.rank(750), 750);
+}
+
+TEST(BulkConstructionTestSuite, UnsortedRangeAndAssign) {
+    std::vector<int32_t> values = {25, 15, 10, 4, 12, 22, 18, 24, 50, 35, 31, 44, 70, 66, 90, 25, 4};
+
+    BinarySearchTree<int32_t> bst(values.begin(), values.end());
+    std::sort(values.begin(), values.end());
+
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), values);
+    ASSERT_EQ(bst.count(25), 2);
+    ASSERT_EQ(Height(bst), 5);
+
+    std::istringstream input("5 3 9 1");
+    bst.assign(std::istream_iterator<int32_t>(input), std::istream_iterator<int32_t>());
+
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), std::vector<int32_t>({1, 3, 5, 9}));
+    ASSERT_EQ(bst.size(), 4);
+
+    std::vector<int32_t> empty;
+    bst.assign(empty.begin(), empty.end());
+    ASSERT_TRUE(bst.empty());
+    ASSERT_TRUE(bst.begin() == bst.end());
+}
+
+TEST(PreOrderIteratorTestSuite, RandomShapes) {
+    BinarySearchTree<int32_t> bst;
+
+    std::mt19937 generator(7);
+    for (int32_t i = 0; i < 1000; ++i) {
+        bst.insert(static_cast<int32_t>(generator() % 500));
+    }
+
+    std::vector<int32_t> predict;
+    std::vector<decltype(bst.begin().Get())> stack = {bst.begin(pre).Get()};
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        predict.push_back(node->value);
+
+        if (node->right) {
+            stack.push_back(node->right);
+        }
+        if (node->left) {
+            stack.push_back(node->left);
+        }
+    }
+
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(pre), bst.end(pre)), predict);
+
+    std::reverse(predict.begin(), predict.end());
+    ASSERT_EQ(std::vector<int32_t>(bst.rbegin(pre), bst.rend(pre)), predict);
+}
+
+TEST(PreOrderIteratorTestSuite, RightmostWithLeftSubtree) {
+    BinarySearchTree<int32_t> bst;
+
+    bst.insert(10);
+    bst.insert(20);
+    bst.insert(15);
+    bst.insert(12);
+    bst.insert(17);
+
+    auto it = bst.end(pre);
+
+    ASSERT_EQ(*(--it), 17);
+    ASSERT_EQ(*(--it), 12);
+    ASSERT_EQ(*(--it), 15);
+    ASSERT_EQ(*(--it), 20);
+    ASSERT_EQ(*(--it), 10);
+    ASSERT_TRUE(it == bst.begin(pre));
+    ASSERT_EQ(bst.back(pre), 17);
+}
+
+TEST(PostOrderIteratorTestSuite, RandomShapes) {
+    BinarySearchTree<int32_t> bst;
+
+    ASSERT_TRUE(bst.begin(post) == bst.end(post));
+
+    std::mt19937 generator(11);
+    for (int32_t i = 0; i < 1000; ++i) {
+        bst.insert(static_cast<int32_t>(generator() % 500));
+    }
+
+    std::vector<int32_t> predict;
+    std::vector<decltype(bst.begin().Get())> stack = {bst.begin(pre).Get()};
+    while (!stack.empty()) {
+        auto node = stack.back();
+        stack.pop_back();
+        predict.push_back(node->value);
+
+        if (node->left) {
+            stack.push_back(node->left);
+        }
+        if (node->right) {
+            stack.push_back(node->right);
+        }
+    }
+    std::reverse(predict.begin(), predict.end());
+
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(post), bst.end(post)), predict);
+    ASSERT_EQ(std::vector<int32_t>(bst.cbegin(post), bst.cend(post)), predict);
+
+    std::reverse(predict.begin(), predict.end());
+    ASSERT_EQ(std::vector<int32_t>(bst.rbegin(post), bst.rend(post)), predict);
+}
+
+TEST(PostOrderIteratorTestSuite, LeftmostWithRightSubtree) {
+    BinarySearchTree<int32_t> bst;
+
+    bst.insert(20);
+    bst.insert(10);
+    bst.insert(15);
+    bst.insert(12);
+    bst.insert(17);
+
+    std::vector<int32_t> predict = {12, 17, 15, 10, 20};
+
+    ASSERT_EQ(bst.front(post), 12);
+    ASSERT_EQ(bst.back(post), 20);
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(post), bst.end(post)), predict);
+}
+
+struct CopyCounter {
+    static inline size_t copies = 0;
+
+    int32_t key = 0;
+
+    CopyCounter() = default;
+    CopyCounter(int32_t key) : key(key) {}
+    CopyCounter(const CopyCounter& other) : key(other.key) {
+        copies += 1;
+    }
+    CopyCounter& operator=(const CopyCounter& other) {
+        key = other.key;
+        copies += 1;
+
+        return *this;
+    }
+    CopyCounter(CopyCounter&& other) noexcept : key(other.key) {}
+    CopyCounter& operator=(CopyCounter&& other) noexcept {
+        key = other.key;
+
+        return *this;
+    }
+
+    bool operator<(const CopyCounter& other) const {
+        return key < other.key;
+    }
+};
+
+TEST(NodeHandleTestSuite, ExtractAndInsert) {
+    RedBlackTree bst;
+    RedBlackTree other;
+
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i);
+    }
+
+    const int32_t* address = &*bst.find(50);
+    auto node = bst.extract(50);
+
+    ASSERT_FALSE(node.empty());
+    ASSERT_EQ(node.value(), 50);
+    ASSERT_EQ(&node.value(), address);
+    ASSERT_EQ(bst.size(), 99);
+    ASSERT_FALSE(bst.contains(50));
+    ASSERT_TRUE(IsValidRedBlackTree(bst));
+
+    ASSERT_TRUE(bst.extract(50).empty());
+
+    auto it = other.insert(std::move(node));
+    ASSERT_TRUE(node.empty());
+    ASSERT_EQ(&*it, address);
+    ASSERT_EQ(other.size(), 1);
+    ASSERT_TRUE(other.insert(RedBlackTree::node_type()) == other.end());
+
+    auto dropped = bst.extract(bst.find(10));
+    ASSERT_EQ(dropped.value(), 10);
+    ASSERT_EQ(bst.size(), 98);
+}
+
+TEST(NodeHandleTestSuite, EraseRelinksSuccessor) {
+    BinarySearchTree<CopyCounter> bst;
+
+    for (int32_t key : {50, 30, 70, 20, 40, 60, 80, 65}) {
+        bst.insert(key);
+    }
+
+    const CopyCounter* successor = &*bst.find(60);
+    CopyCounter::copies = 0;
+
+    bst.erase(50);
+    auto node = bst.extract(60);
+
+    ASSERT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(&node.value(), successor);
+
+    std::vector<int32_t> result;
+    for (const CopyCounter& value : bst) {
+        result.push_back(value.key);
+    }
+
+    ASSERT_EQ(result, std::vector<int32_t>({20, 30, 40, 65, 70, 80}));
+}
+
+TEST(NodeHandleTestSuite, MergeKeepsBalance) {
+    RedBlackTree bst;
+    RedBlackTree other;
+
+    for (int32_t i = 0; i < 512; ++i) {
+        bst.insert(i * 2);
+        other.insert(i * 2 + 1);
+    }
+
+    const int32_t* address = &*other.find(101);
+    bst.merge(other);
+
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(bst.size(), 1024);
+    ASSERT_EQ(&*bst.find(101), address);
+    ASSERT_TRUE(IsValidRedBlackTree(bst));
+
+    std::vector<int32_t> predict(1024);
+    std::iota(predict.begin(), predict.end(), 0);
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), predict);
+
+    AvlTree avl;
+    OrderStatisticTree statistic;
+    for (int32_t i = 0; i < 256; ++i) {
+        avl.insert(i);
+        statistic.insert(i);
+    }
+
+    for (int32_t i = 0; i < 256; i += 3) {
+        avl.insert(avl.extract(i));
+        statistic.insert(statistic.extract(i));
+    }
+
+    ASSERT_TRUE(IsValidAvlTree(avl));
+    for (int32_t i = 0; i < 256; ++i) {
+        ASSERT_EQ(*statistic.nth_element(i), i);
+    }
+}
+
+TEST(NodeHandleTestSuite, MergeAcrossPools) {
+    BinarySearchTree<int32_t, std::less<int32_t>, PoolAllocator<int32_t>> bst;
+    BinarySearchTree<int32_t, std::less<int32_t>, PoolAllocator<int32_t>> other;
+
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i);
+        other.insert(i + 100);
+    }
+
+    bst.merge(other);
+
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(bst.size(), 200);
+    ASSERT_EQ(bst.front(), 0);
+    ASSERT_EQ(bst.back(), 199);
+}
+
+TEST(EmplaceTestSuite, MoveInsertAndEmplace) {
+    BinarySearchTree<CopyCounter> bst;
+    CopyCounter::copies = 0;
+
+    CopyCounter value(5);
+    bst.insert(std::move(value));
+    bst.emplace(3);
+    bst.emplace_hint(bst.end(), 9);
+    auto [it, inserted] = bst.emplace(CopyCounter(7));
+
+    ASSERT_TRUE(inserted);
+    ASSERT_EQ(it->value.key, 7);
+    ASSERT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(bst.size(), 4);
+
+    std::vector<int32_t> result;
+    for (const CopyCounter& element : bst) {
+        result.push_back(element.key);
+    }
+
+    ASSERT_EQ(result, std::vector<int32_t>({3, 5, 7, 9}));
+}
+
+TEST(EmplaceTestSuite, EmplaceUnique) {
+    BinarySearchTree<CopyCounter> bst;
+
+    for (int32_t i = 0; i < 10; ++i) {
+        ASSERT_TRUE(bst.emplace_unique(i * 2).second);
+    }
+
+    CopyCounter::copies = 0;
+
+    CopyCounter existing(4);
+    auto [found, inserted] = bst.emplace_unique(existing);
+    ASSERT_FALSE(inserted);
+    ASSERT_EQ(found->value.key, 4);
+    ASSERT_EQ(CopyCounter::copies, 0);
+
+    ASSERT_FALSE(bst.emplace_unique(6).second);
+    ASSERT_TRUE(bst.emplace_unique(CopyCounter(5)).second);
+    ASSERT_EQ(CopyCounter::copies, 0);
+    ASSERT_EQ(bst.size(), 11);
+
+    RedBlackTree unique;
+    for (int32_t i = 0; i < 1000; ++i) {
+        unique.emplace_unique(i % 100);
+    }
+
+    ASSERT_EQ(unique.size(), 100);
+    ASSERT_TRUE(IsValidRedBlackTree(unique));
+}
+
+TEST(EmplaceTestSuite, StringsAreMovedIn) {
+    BinarySearchTree<std::string> bst;
+
+    std::string value(1000, 'x');
+    const char* buffer = value.data();
+    auto it = bst.insert(std::move(value)).first;
+
+    ASSERT_EQ(it->value.data(), buffer);
+    ASSERT_EQ(bst.emplace(3, 'a').first->value, "aaa");
+    ASSERT_EQ(bst.front(), "aaa");
+}
+
+struct CountingLess {
+    static inline size_t calls = 0;
+
+    bool operator()(int32_t lhs, int32_t rhs) const {
+        calls += 1;
+
+        return lhs < rhs;
+    }
+};
+
+TEST(HintedInsertTestSuite, AppendAtEnd) {
+    BinarySearchTree<int32_t, CountingLess, std::allocator<int32_t>, RedBlackBalance> bst;
+    CountingLess::calls = 0;
+
+    for (int32_t i = 0; i < 1000; ++i) {
+        bst.insert(bst.end(), i);
+    }
+
+    ASSERT_LE(CountingLess::calls, 1000);
+    ASSERT_EQ(bst.size(), 1000);
+
+    std::vector<int32_t> predict(1000);
+    std::iota(predict.begin(), predict.end(), 0);
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), predict);
+}
+
+TEST(HintedInsertTestSuite, NearlySortedAndWrongHints) {
+    RedBlackTree bst;
+    std::mt19937 generator(7);
+    std::vector<int32_t> predict;
+
+    auto hint = bst.end();
+    for (int32_t i = 0; i < 2000; ++i) {
+        int32_t key = (generator() % 10 == 0) ? static_cast<int32_t>(generator() % 2000) : i;
+        predict.push_back(key);
+
+        hint = bst.insert(hint, key);
+        ++hint;
+        ASSERT_TRUE(IsValidRedBlackTree(bst));
+    }
+
+    for (int32_t i = 0; i < 100; ++i) {
+        int32_t key = static_cast<int32_t>(generator() % 2000);
+        predict.push_back(key);
+
+        bst.emplace_hint(bst.nth_element(generator() % bst.size()), key);
+    }
+
+    std::sort(predict.begin(), predict.end());
+    ASSERT_TRUE(IsValidRedBlackTree(bst));
+    ASSERT_EQ(std::vector<int32_t>(bst.begin(), bst.end()), predict);
+
+    BinarySearchTree<int32_t> plain;
+    plain.insert(plain.begin(), 5);
+    plain.insert(plain.begin(), 3);
+    plain.insert(plain.find(5), 4);
+    plain.insert(plain.find(3), 6);
+    plain.insert(plain.end(), 1);
+
+    ASSERT_EQ(std::vector<int32_t>(plain.begin(), plain.end()), std::vector<int32_t>({1, 3, 4, 5, 6}));
+}
+
+struct Employee {
+    int32_t id;
+    std::string name;
+};
+
+struct ById {
+    using is_transparent = void;
+
+    bool operator()(const Employee& lhs, const Employee& rhs) const {
+        return lhs.id < rhs.id;
+    }
+    bool operator()(const Employee& lhs, int32_t rhs) const {
+        return lhs.id < rhs;
+    }
+    bool operator()(int32_t lhs, const Employee& rhs) const {
+        return lhs < rhs.id;
+    }
+};
+
+TEST(TransparentLookupTestSuite, LookupByMember) {
+    BinarySearchTree<Employee, ById> bst;
+
+    for (int32_t i = 0; i < 100; i += 2) {
+        bst.insert(Employee{i, "employee " + std::to_string(i)});
+    }
+    bst.insert(Employee{10, "duplicate"});
+
+    ASSERT_EQ(bst.find(42)->value.name, "employee 42");
+    ASSERT_TRUE(bst.find(43) == bst.end());
+    ASSERT_TRUE(bst.contains(0));
+    ASSERT_FALSE(bst.contains(99));
+    ASSERT_EQ(bst.count(10), 2);
+    ASSERT_EQ(bst.count(11), 0);
+    ASSERT_EQ(bst.lower_bound(11)->value.id, 12);
+    ASSERT_EQ(bst.upper_bound(12)->value.id, 14);
+    ASSERT_EQ(bst.lower_bound_node(98)->value.id, 98);
+    ASSERT_TRUE(bst.upper_bound_node(98) == nullptr);
+
+    auto [lower, upper] = bst.equal_range(10);
+    ASSERT_EQ(std::distance(lower, upper), 2);
+    ASSERT_EQ(upper->value.id, 12);
+
+    auto [lower_node, upper_node] = bst.equal_range_node(50);
+    ASSERT_EQ(lower_node->value.id, 50);
+    ASSERT_EQ(upper_node->value.id, 52);
+}
+
+TEST(TransparentLookupTestSuite, StringViewKeys) {
+    BinarySearchTree<std::string, std::less<>> bst;
+
+    bst.insert("apple");
+    bst.insert("banana");
+    bst.insert("cherry");
+
+    std::string_view key = "banana";
+    ASSERT_EQ(*bst.find(key), "banana");
+    ASSERT_TRUE(bst.contains("cherry"));
+    ASSERT_FALSE(bst.contains(std::string_view("durian")));
+    ASSERT_EQ(*bst.lower_bound("b"), "banana");
+    ASSERT_EQ(bst.count("apple"), 1);
+}
+
+template <typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    static inline size_t allocations = 0;
+
+    CountingAllocator() = default;
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t count) {
+        CountingAllocator<int32_t>::allocations += 1;
+
+        return std::allocator<T>().allocate(count);
+    }
+
+    void deallocate(T* ptr, size_t count) {
+        std::allocator<T>().deallocate(ptr, count);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U>&) const {
+        return true;
+    }
+};
+
+TEST(UniqueInsertTestSuite, HitsDoNotAllocate) {
+    BinarySearchTree<int32_t, std::less<int32_t>, CountingAllocator<int32_t>, RedBlackBalance> bst;
+    CountingAllocator<int32_t>::allocations = 0;
+
+    for (int32_t i = 0; i < 10000; ++i) {
+        auto [it, inserted] = bst.insert_unique(i % 100);
+
+        ASSERT_EQ(inserted, i < 100);
+        ASSERT_EQ(*it, i % 100);
+    }
+
+    ASSERT_EQ(bst.size(), 100);
+    ASSERT_EQ(CountingAllocator<int32_t>::allocations, 100);
+
+    int32_t key = 50;
+    ASSERT_FALSE(bst.insert_unique(key).second);
+    ASSERT_TRUE(bst.insert_unique(150).second);
+    ASSERT_EQ(CountingAllocator<int32_t>::allocations, 101);
+
+    bst.insert(5);
+    ASSERT_EQ(bst.count(5), 2);
+    ASSERT_FALSE(bst.insert_unique(5).second);
+    ASSERT_EQ(bst.count(5), 2);
+}
+
+struct CountingThreeWay {
+    static inline size_t calls = 0;
+
+    std::strong_ordering operator()(int32_t lhs, int32_t rhs) const {
+        calls += 1;
+
+        return lhs <=> rhs;
+    }
+};
+
+TEST(ThreeWayCompareTestSuite, HalvesComparatorCalls) {
+    std::vector<int32_t> keys(1023);
+    std::iota(keys.begin(), keys.end(), 0);
+
+    BinarySearchTree<int32_t, CountingLess> two_way(keys.begin(), keys.end());
+    BinarySearchTree<int32_t, CountingThreeWay> three_way(keys.begin(), keys.end());
+
+    CountingLess::calls = 0;
+    CountingThreeWay::calls = 0;
+    for (int32_t key : keys) {
+        ASSERT_EQ(*two_way.find(key), key);
+        ASSERT_EQ(*three_way.find(key), key);
+    }
+
+    // A perfectly balanced tree of 1023 keys is 10 levels deep
+    ASSERT_LE(CountingThreeWay::calls, keys.size() * 10);
+    ASSERT_LT(CountingThreeWay::calls * 3, CountingLess::calls * 2);
+
+    CountingThreeWay::calls = 0;
+    for (int32_t key = 0; key < 1023; key += 2) {
+        three_way.erase(key);
+    }
+    ASSERT_LE(CountingThreeWay::calls, 512 * 10);
+
+    ASSERT_EQ(three_way.size(), 511);
+    ASSERT_EQ(three_way.count(3), 1);
+    ASSERT_EQ(three_way.count(4), 0);
+    ASSERT_EQ(*three_way.lower_bound(4), 5);
+    ASSERT_EQ(*three_way.upper_bound(5), 7);
+    ASSERT_TRUE(three_way.insert_unique(7).first == three_way.find(7));
+    ASSERT_TRUE(three_way.insert_unique(8).second);
+    ASSERT_TRUE(three_way.value_comp()(1, 2));
+}
+
+TEST(BatchLookupTestSuite, MatchesSingleLookups) {
+    RedBlackTree bst;
+    std::mt19937 generator(19);
+
+    for (int32_t i = 0; i < 5000; ++i) {
+        bst.insert(static_cast<int32_t>(generator() % 20000));
+    }
+
+    std::vector<int32_t> keys;
+    for (int32_t i = 0; i < 1000; ++i) {
+        keys.push_back(static_cast<int32_t>(generator() % 21000) - 500);
+    }
+
+    std::vector<RedBlackTree::InOrderIterator<false>> found;
+    std::vector<bool> contained;
+    std::vector<RedBlackTree::InOrderIterator<false>> lower;
+
+    bst.find_batch(keys, std::back_inserter(found));
+    bst.contains_batch(keys, std::back_inserter(contained));
+    bst.lower_bound_batch(keys, std::back_inserter(lower));
+
+    ASSERT_EQ(found.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        ASSERT_TRUE(found[i] == bst.find(keys[i]));
+        ASSERT_EQ(contained[i], bst.contains(keys[i]));
+        ASSERT_TRUE(lower[i] == bst.lower_bound(keys[i]));
+    }
+
+    RedBlackTree empty;
+    std::vector<bool> none;
+    empty.contains_batch(std::span<const int32_t>(keys.data(), 3), std::back_inserter(none));
+    ASSERT_EQ(none, std::vector<bool>({false, false, false}));
+}
+
+TEST(BatchLookupTestSuite, SplayTreeAccessesFoundKeys) {
+    SplayTree bst;
+    for (int32_t i = 0; i < 100; ++i) {
+        bst.insert(i);
+    }
+
+    std::vector<int32_t> keys = {10, 200, 42};
+    std::vector<SplayTree::InOrderIterator<false>> found;
+    bst.find_batch(keys, std::back_inserter(found));
+
+    ASSERT_EQ(*found[0], 10);
+    ASSERT_TRUE(found[1] == bst.end());
+    ASSERT_EQ(*found[2], 42);
+    ASSERT_EQ(*bst.begin(pre), 42);
+
+    std::vector<bool> contained;
+    bst.contains_batch(std::vector<int32_t>{7, 300}, std::back_inserter(contained));
+
+    ASSERT_EQ(contained, std::vector<bool>({true, false}));
+    ASSERT_EQ(*bst.begin(pre), 7);
+}
+
+TEST(CompactTreeTestSuite, MatchesPointerLayout) {
+    BinarySearchTree<int32_t> bst;
+    CompactBinarySearchTree<int32_t> compact;
+    std::mt19937 generator(20);
+
+    for (int32_t i = 0; i < 2000; ++i) {
+        int32_t key = static_cast<int32_t>(generator() % 1000);
+        bst.insert(key);
+        compact.insert(key);
+    }
+
+    for (int32_t i = 0; i < 1000; i += 3) {
+        size_t erased = bst.contains(i) ? 1 : 0;
+        ASSERT_EQ(bst.erase(i), erased);
+        ASSERT_EQ(compact.erase(i), erased);
+    }
+
+    ASSERT_EQ(compact.size(), bst.size());
+    ASSERT_EQ(std::vector<int32_t>(compact.begin(), compact.end()), std::vector<int32_t>(bst.begin(), bst.end()));
+    ASSERT_EQ(std::vector<int32_t>(compact.begin(pre), compact.end(pre)),
+              std::vector<int32_t>(bst.begin(pre), bst.end(pre)));
+    ASSERT_EQ(std::vector<int32_t>(compact.begin(post), compact.end(post)),
+              std::vector<int32_t>(bst.begin(post), bst.end(post)));
+    ASSERT_EQ(std::vector<int32_t>(compact.rbegin(), compact.rend()), std::vector<int32_t>(bst.rbegin(), bst.rend()));
+    ASSERT_EQ(std::vector<int32_t>(compact.rbegin(pre), compact.rend(pre)),
+              std::vector<int32_t>(bst.rbegin(pre), bst.rend(pre)));
+    ASSERT_EQ(std::vector<int32_t>(compact.rbegin(post), compact.rend(post)),
+              std::vector<int32_t>(bst.rbegin(post), bst.rend(post)));
+
+    for (int32_t key = -1; key <= 1000; ++key) {
+        ASSERT_EQ(compact.contains(key), bst.contains(key));
+        ASSERT_EQ(compact.count(key), bst.count(key));
+    }
+
+    ASSERT_EQ(compact.front(), bst.front());
+    ASSERT_EQ(compact.back(), bst.back());
+    ASSERT_EQ(*compact.lower_bound(500), *bst.lower_bound(500));
+    ASSERT_EQ(*compact.upper_bound(500), *bst.upper_bound(500));
+}
+
+TEST(CompactTreeTestSuite, FootprintAndStableIterators) {
+    ASSERT_EQ(CompactBinarySearchTree<int32_t>::node_size(), 16);
+
+    std::vector<int32_t> keys(1000);
+    std::iota(keys.begin(), keys.end(), 0);
+    CompactBinarySearchTree<int32_t> compact(keys.begin(), keys.end());
+
+    ASSERT_EQ(compact.memory_usage(), 1000 * 16);
+    ASSERT_EQ(*compact.begin(pre), 499);
+
+    auto it = compact.find(10);
+    for (int32_t i = 1000; i < 5000; ++i) {
+        compact.insert(i);
+    }
+
+    ASSERT_EQ(*it, 10);
+    ASSERT_EQ(*++it, 11);
+
+    size_t capacity = compact.capacity();
+    for (int32_t i = 0; i < 100; ++i) {
+        compact.erase(i);
+    }
+    for (int32_t i = 0; i < 100; ++i) {
+        compact.insert(-i);
+    }
+
+    ASSERT_EQ(compact.capacity(), capacity);
+    ASSERT_EQ(compact.size(), 5000);
+    ASSERT_EQ(compact.front(), -99);
+
+    CompactBinarySearchTree<int32_t> copy = compact;
+    ASSERT_TRUE(copy == compact);
+    copy.erase(2000);
+    ASSERT_TRUE(copy != compact);
+}
+
+TEST(CompactTreeTestSuite, ThreeWayComparator) {
+    std::vector<int32_t> keys = {50, 20, 80, 20, 10, 90, 60};
+    CompactBinarySearchTree<int32_t, CountingThreeWay> compact(keys.begin(), keys.end());
+    BinarySearchTree<int32_t, CountingThreeWay> pointer(keys.begin(), keys.end());
+
+    compact.insert(70);
+    pointer.insert(70);
+    compact.erase(90);
+    pointer.erase(90);
+
+    ASSERT_EQ(std::vector<int32_t>(compact.begin(), compact.end()), std::vector<int32_t>(pointer.begin(), pointer.end()));
+    ASSERT_TRUE(compact.contains(60));
+    ASSERT_FALSE(compact.contains(90));
+    ASSERT_EQ(compact.count(20), 2);
+    ASSERT_EQ(*compact.lower_bound(55), 60);
+    ASSERT_EQ(*compact.upper_bound(20), 50);
+
+    auto copy = compact;
+    ASSERT_TRUE(copy == compact);
+}
+
+TEST(FrozenTreeTestSuite, MatchesMutableTree) {
+    RedBlackTree bst;
+    std::mt19937 generator(21);
+
+    for (int32_t i = 0; i < 3000; ++i) {
+        bst.insert(static_cast<int32_t>(generator() % 2000));
+    }
+
+    FrozenBinarySearchTree<int32_t> frozen = bst.freeze();
+    ASSERT_EQ(frozen.size(), bst.size());
+    ASSERT_EQ(std::vector<int32_t>(frozen.begin(), frozen.end()), std::vector<int32_t>(bst.begin(), bst.end()));
+    ASSERT_EQ(std::vector<int32_t>(frozen.rbegin(), frozen.rend()), std::vector<int32_t>(bst.rbegin(), bst.rend()));
+    ASSERT_EQ(frozen.front(), bst.front());
+    ASSERT_EQ(frozen.back(), bst.back());
+
+    for (int32_t key = -1; key <= 2001; ++key) {
+        ASSERT_EQ(frozen.contains(key), bst.contains(key));
+        ASSERT_EQ(frozen.count(key), bst.count(key));
+
+        auto lower = frozen.lower_bound(key);
+        auto upper = frozen.upper_bound(key);
+        ASSERT_EQ(lower == frozen.end(), bst.lower_bound(key) == bst.end());
+        ASSERT_EQ(upper == frozen.end(), bst.upper_bound(key) == bst.end());
+        if (lower != frozen.end()) {
+            ASSERT_EQ(*lower, *bst.lower_bound(key));
+        }
+        if (upper != frozen.end()) {
+            ASSERT_EQ(*upper, *bst.upper_bound(key));
+        }
+    }
+
+    auto it = frozen.find(bst.front());
+    ASSERT_TRUE(it == frozen.begin());
+    ASSERT_TRUE(frozen.find(5000) == frozen.end());
+}
+
+TEST(FrozenTreeTestSuite, ThawAndEmpty) {
+    std::vector<int32_t> keys(1000);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(22));
+
+    FrozenBinarySearchTree<int32_t> frozen(keys.begin(), keys.end());
+    std::sort(keys.begin(), keys.end());
+
+    BinarySearchTree<int32_t> thawed = frozen.thaw();
+    ASSERT_EQ(std::vector<int32_t>(thawed.begin(), thawed.end()), keys);
+    ASSERT_LE(Height(thawed), 10);
+
+    RedBlackTree red_black = frozen.thaw<RedBlackTree>();
+    ASSERT_TRUE(IsValidRedBlackTree(red_black));
+    ASSERT_EQ(red_black.size(), 1000);
+
+    FrozenBinarySearchTree<int32_t> empty = BinarySearchTree<int32_t>().freeze();
+    ASSERT_TRUE(empty.empty());
+    ASSERT_TRUE(empty.begin() == empty.end());
+    ASSERT_TRUE(empty.lower_bound(1) == empty.end());
+    ASSERT_FALSE(empty.contains(1));
+    ASSERT_TRUE(empty.thaw().empty());
+}
+
+TEST(BPlusTreeTestSuite, MatchesPointerLayout) {
+    BinarySearchTree<int32_t> bst;
+    BPlusTree<int32_t> bplus;
+    std::mt19937 generator(23);
+
+    ASSERT_EQ(BPlusTree<int32_t>::node_capacity(), 16);
+
+    for (int32_t i = 0; i < 20000; ++i) {
+        int32_t key = static_cast<int32_t>(generator() % 5000);
+        bst.insert(key);
+        ASSERT_EQ(*bplus.insert(key).first, key);
+    }
+
+    ASSERT_EQ(std::vector<int32_t>(bplus.begin(), bplus.end()), std::vector<int32_t>(bst.begin(), bst.end()));
+
+    for (int32_t i = 0; i < 30000; ++i) {
+        int32_t key = static_cast<int32_t>(generator() % 5000);
+        size_t erased = bst.contains(key) ? 1 : 0;
+        ASSERT_EQ(bst.erase(key), erased);
+        ASSERT_EQ(bplus.erase(key), erased);
+    }
+
+    ASSERT_EQ(bplus.size(), bst.size());
+    ASSERT_EQ(std::vector<int32_t>(bplus.begin(), bplus.end()), std::vector<int32_t>(bst.begin(), bst.end()));
+    ASSERT_EQ(std::vector<int32_t>(bplus.rbegin(), bplus.rend()), std::vector<int32_t>(bst.rbegin(), bst.rend()));
+
+    for (int32_t key = -1; key <= 5000; ++key) {
+        ASSERT_EQ(bplus.contains(key), bst.contains(key));
+        ASSERT_EQ(bplus.count(key), bst.count(key));
+        ASSERT_EQ(bplus.lower_bound(key) == bplus.end(), bst.lower_bound(key) == bst.end());
+        if (bplus.lower_bound(key) != bplus.end()) {
+            ASSERT_EQ(*bplus.lower_bound(key), *bst.lower_bound(key));
+        }
+        if (bplus.upper_bound(key) != bplus.end()) {
+            ASSERT_EQ(*bplus.upper_bound(key), *bst.upper_bound(key));
+        }
+    }
+
+    BPlusTree<int32_t> copy = bplus;
+    ASSERT_TRUE(copy == bplus);
+    while (!copy.empty()) {
+        copy.erase(copy.front());
+    }
+    ASSERT_EQ(copy.height(), 0);
+    ASSERT_TRUE(copy.begin() == copy.end());
+}
+
+TEST(BPlusTreeTestSuite, KeyTypesAndBulkBuild) {
+    std::vector<double> keys(5000);
+    std::iota(keys.begin(), keys.end(), 0.0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(24));
+
+    BPlusTree<double> doubles(keys.begin(), keys.end());
+    ASSERT_EQ(BPlusTree<double>::node_capacity(), 8);
+    ASSERT_EQ(doubles.front(), 0.0);
+    ASSERT_EQ(doubles.back(), 4999.0);
+    ASSERT_EQ(*doubles.lower_bound(10.5), 11.0);
+    ASSERT_EQ(*doubles.upper_bound(11.0), 12.0);
+    ASSERT_LE(doubles.height(), 5);
+
+    for (double key = 0.0; key < 5000.0; key += 2.0) {
+        ASSERT_EQ(doubles.erase(key), 1);
+    }
+    ASSERT_EQ(doubles.size(), 2500);
+    ASSERT_EQ(*doubles.find(101.0), 101.0);
+    ASSERT_TRUE(doubles.find(100.0) == doubles.end());
+
+    BPlusTree<std::string> strings;
+    ASSERT_FALSE(BPlusTree<std::string>::is_vectorized());
+    for (int32_t i = 0; i < 500; ++i) {
+        strings.emplace(3, static_cast<char>('a' + i % 26));
+    }
+    ASSERT_EQ(strings.count("zzz"), 19);
+    ASSERT_EQ(strings.size(), 500);
+    ASSERT_EQ(*--strings.end(), "zzz");
+
+    BPlusTree<int32_t, std::greater<int32_t>> descending;
+    for (int32_t i = 0; i < 100; ++i) {
+        descending.insert(i);
+    }
+    ASSERT_EQ(descending.front(), 99);
+    ASSERT_EQ(*descending.lower_bound(50), 50);
+}
+
+TEST(SetAlgebraTestSuite, MatchesStandardAlgorithms) {
+    RedBlackTree lhs;
+    RedBlackTree rhs;
+    std::mt19937 generator(25);
+
+    for (int32_t i = 0; i < 3000; ++i) {
+        lhs.insert(static_cast<int32_t>(generator() % 1500));
+        rhs.insert(static_cast<int32_t>(generator() % 1500) + 500);
+    }
+
+    std::vector<int32_t> left(lhs.begin(), lhs.end());
+    std::vector<int32_t> right(rhs.begin(), rhs.end());
+    std::vector<int32_t> expected;
+
+    RedBlackTree united = lhs.merge_union(rhs);
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    ASSERT_EQ(std::vector<int32_t>(united.begin(), united.end()), expected);
+    ASSERT_EQ(united.size(), expected.size());
+    ASSERT_TRUE(IsValidRedBlackTree(united));
+
+    expected.clear();
+    RedBlackTree common = lhs.intersect(rhs);
+    std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    ASSERT_EQ(std::vector<int32_t>(common.begin(), common.end()), expected);
+    ASSERT_TRUE(IsValidRedBlackTree(common));
+
+    expected.clear();
+    RedBlackTree rest = lhs.difference(rhs);
+    std::set_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    ASSERT_EQ(std::vector<int32_t>(rest.begin(), rest.end()), expected);
+    ASSERT_TRUE(IsValidRedBlackTree(rest));
+
+    expected.clear();
+    RedBlackTree either = lhs.symmetric_difference(rhs);
+    std::set_symmetric_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    ASSERT_EQ(std::vector<int32_t>(either.begin(), either.end()), expected);
+    ASSERT_TRUE(IsValidRedBlackTree(either));
+
+    ASSERT_EQ(lhs.size(), 3000);
+    ASSERT_EQ(rhs.size(), 3000);
+}
+
+TEST(SetAlgebraTestSuite, EmptyAndCustomOrder) {
+    BinarySearchTree<int32_t, std::greater<int32_t>> lhs;
+    BinarySearchTree<int32_t, std::greater<int32_t>> rhs;
+    for (int32_t i = 0; i < 10; ++i) {
+        lhs.insert(i);
+        rhs.insert(i + 5);
+    }
+
+    auto united = lhs.merge_union(rhs);
+    ASSERT_EQ(std::vector<int32_t>(united.begin(), united.end()),
+              std::vector<int32_t>({14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+    ASSERT_EQ(united.front(), 14);
+    ASSERT_EQ(united.back(), 0);
+    ASSERT_LE(Height(united), 4);
+
+    auto common = lhs.intersect(rhs);
+    ASSERT_EQ(std::vector<int32_t>(common.begin(), common.end()), std::vector<int32_t>({9, 8, 7, 6, 5}));
+
+    BinarySearchTree<int32_t, std::greater<int32_t>> empty;
+    ASSERT_TRUE(empty.intersect(lhs).empty());
+    ASSERT_TRUE(lhs.difference(lhs).empty());
+    ASSERT_EQ(empty.merge_union(lhs).size(), 10);
+    ASSERT_TRUE(empty.symmetric_difference(empty).empty());
+}
+
+std::vector<int32_t> SortedKeys(size_t count, std::mt19937& generator) {
+    std::vector<int32_t> keys(count);
+    for (int32_t& key : keys) {
+        key = static_cast<int32_t>(generator() % 1000);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    return keys;
+}
+
+TEST(SetAlgebraTestSuite, ConsumingUnionJoinsSmallTreeIntoLarge) {
+    std::mt19937 generator(23);
+    std::vector<int32_t> large = SortedKeys(3000, generator);
+    std::vector<int32_t> small = SortedKeys(40, generator);
+    std::vector<int32_t> expected;
+    std::set_union(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+
+    RedBlackTree lhs(large.begin(), large.end());
+    RedBlackTree rhs(small.begin(), small.end());
+    RedBlackTree united = RedBlackTree::merge_union(std::move(lhs), std::move(rhs));
+
+    ASSERT_TRUE(lhs.empty());
+    ASSERT_TRUE(rhs.empty());
+    ASSERT_TRUE(IsValidRedBlackTree(united));
+    ASSERT_EQ(united.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(united.begin(), united.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(united.rbegin(), united.rend()), std::vector<int32_t>(expected.rbegin(), expected.rend()));
+
+    expected.clear();
+    std::set_union(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(expected));
+    united = RedBlackTree::merge_union(RedBlackTree(small.begin(), small.end()), RedBlackTree(large.begin(), large.end()));
+    ASSERT_TRUE(IsValidRedBlackTree(united));
+    ASSERT_EQ(std::vector<int32_t>(united.begin(), united.end()), expected);
+
+    auto first = united.begin().Get();
+    RedBlackTree same = RedBlackTree::merge_union(std::move(united), RedBlackTree());
+    ASSERT_EQ(same.begin().Get(), first);
+    ASSERT_EQ(same.size(), expected.size());
+}
+
+TEST(SetAlgebraTestSuite, ConsumingIntersectionAndDifferencesOfSmallTree) {
+    std::mt19937 generator(24);
+    std::vector<int32_t> large = SortedKeys(3000, generator);
+    std::vector<int32_t> small = SortedKeys(40, generator);
+
+    std::vector<int32_t> expected;
+    std::set_intersection(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+    RedBlackTree common = RedBlackTree::intersect(RedBlackTree(large.begin(), large.end()),
+                                                  RedBlackTree(small.begin(), small.end()));
+    ASSERT_TRUE(IsValidRedBlackTree(common));
+    ASSERT_EQ(common.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(common.begin(), common.end()), expected);
+
+    expected.clear();
+    std::set_difference(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+    RedBlackTree rest = RedBlackTree::difference(RedBlackTree(large.begin(), large.end()),
+                                                 RedBlackTree(small.begin(), small.end()));
+    ASSERT_TRUE(IsValidRedBlackTree(rest));
+    ASSERT_EQ(rest.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(rest.begin(), rest.end()), expected);
+
+    expected.clear();
+    std::set_difference(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(expected));
+    rest = RedBlackTree::difference(RedBlackTree(small.begin(), small.end()), RedBlackTree(large.begin(), large.end()));
+    ASSERT_TRUE(IsValidRedBlackTree(rest));
+    ASSERT_EQ(std::vector<int32_t>(rest.begin(), rest.end()), expected);
+
+    expected.clear();
+    std::set_symmetric_difference(small.begin(), small.end(), large.begin(), large.end(), std::back_inserter(expected));
+    RedBlackTree either = RedBlackTree::symmetric_difference(RedBlackTree(small.begin(), small.end()),
+                                                             RedBlackTree(large.begin(), large.end()));
+    ASSERT_TRUE(IsValidRedBlackTree(either));
+    ASSERT_EQ(either.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(either.begin(), either.end()), expected);
+}
+
+TEST(SetAlgebraTestSuite, ConsumingJoinsKeepAvlTreapAndSubtreeSizes) {
+    std::mt19937 generator(25);
+    std::vector<int32_t> large = SortedKeys(3000, generator);
+    std::vector<int32_t> small = SortedKeys(40, generator);
+
+    std::vector<int32_t> expected;
+    std::set_union(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+    AvlTree avl = AvlTree::merge_union(AvlTree(large.begin(), large.end()), AvlTree(small.begin(), small.end()));
+    ASSERT_TRUE(IsValidAvlTree(avl));
+    ASSERT_EQ(std::vector<int32_t>(avl.begin(), avl.end()), expected);
+
+    expected.clear();
+    std::set_difference(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+    Treap treap = Treap::difference(Treap(large.begin(), large.end()), Treap(small.begin(), small.end()));
+    ASSERT_TRUE(IsValidTreap(treap));
+    ASSERT_EQ(std::vector<int32_t>(treap.begin(), treap.end()), expected);
+
+    expected.clear();
+    std::set_symmetric_difference(large.begin(), large.end(), small.begin(), small.end(), std::back_inserter(expected));
+    OrderStatisticTree ranked = OrderStatisticTree::symmetric_difference(OrderStatisticTree(large.begin(), large.end()),
+                                                                         OrderStatisticTree(small.begin(), small.end()));
+    ASSERT_TRUE(IsValidOrderStatisticTree(ranked));
+    ASSERT_EQ(ranked.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(ranked.begin(), ranked.end()), expected);
+    ASSERT_EQ(*ranked.nth_element(expected.size() / 2), expected[expected.size() / 2]);
+}
+
+TEST(SetAlgebraTestSuite, ConsumingRelinksTreesOfSimilarSize) {
+    std::mt19937 generator(26);
+    std::vector<int32_t> left = SortedKeys(2000, generator);
+    std::vector<int32_t> right = SortedKeys(1500, generator);
+
+    std::vector<int32_t> expected;
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    BinarySearchTree<int32_t> united = BinarySearchTree<int32_t>::merge_union(
+        BinarySearchTree<int32_t>(left.begin(), left.end()), BinarySearchTree<int32_t>(right.begin(), right.end()));
+    ASSERT_EQ(united.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(united.begin(), united.end()), expected);
+    ASSERT_LE(Height(united), std::log2(expected.size() + 1) + 1);
+
+    expected.clear();
+    std::set_intersection(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    SplayTree common = SplayTree::intersect(SplayTree(left.begin(), left.end()), SplayTree(right.begin(), right.end()));
+    ASSERT_EQ(common.size(), expected.size());
+    ASSERT_EQ(std::vector<int32_t>(common.begin(), common.end()), expected);
+
+    expected.clear();
+    std::set_symmetric_difference(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(expected));
+    OrderStatisticTree either = OrderStatisticTree::symmetric_difference(OrderStatisticTree(left.begin(), left.end()),
+                                                                         OrderStatisticTree(right.begin(), right.end()));
+    ASSERT_TRUE(IsValidOrderStatisticTree(either));
+    ASSERT_EQ(std::vector<int32_t>(either.begin(), either.end()), expected);
+}
+
+TEST(SplitJoinTestSuite, RedBlackSplitAndJoinAtEveryBoundary) {
+    std::mt19937 generator(26);
+    std::vector<int32_t> all = SortedKeys(2000, generator);
+    std::vector<int32_t> shuffled = all;
+    std::shuffle(shuffled.begin(), shuffled.end(), generator);
+
+    for (int32_t key : {-5, 0, 1, 250, 500, 999, 1000}) {
+        RedBlackTree tree;
+        for (int32_t value : shuffled) {
+            tree.insert(value);
+        }
+        auto middle = std::lower_bound(all.begin(), all.end(), key);
+
+        auto [lower, upper] = tree.split(key);
+        ASSERT_TRUE(tree.empty());
+        ASSERT_TRUE(IsValidRedBlackTree(lower));
+        ASSERT_TRUE(IsValidRedBlackTree(upper));
+        ASSERT_EQ(std::vector<int32_t>(lower.begin(), lower.end()), std::vector<int32_t>(all.begin(), middle));
+        ASSERT_EQ(std::vector<int32_t>(upper.begin(), upper.end()), std::vector<int32_t>(middle, all.end()));
+        ASSERT_EQ(lower.size(), static_cast<size_t>(middle - all.begin()));
+        ASSERT_EQ(upper.size(), static_cast<size_t>(all.end() - middle));
+        if (!lower.empty()) {
+            ASSERT_EQ(lower.back(), *std::prev(middle));
+        }
+        if (!upper.empty()) {
+            ASSERT_EQ(upper.front(), *middle);
+        }
+
+        RedBlackTree joined = RedBlackTree::join(std::move(lower), std::move(upper));
+        ASSERT_TRUE(lower.empty());
+        ASSERT_TRUE(upper.empty());
+        ASSERT_TRUE(IsValidRedBlackTree(joined));
+        ASSERT_EQ(joined.size(), all.size());
+        ASSERT_EQ(std::vector<int32_t>(joined.begin(), joined.end()), all);
+        ASSERT_EQ(std::vector<int32_t>(joined.rbegin(), joined.rend()), std::vector<int32_t>(all.rbegin(), all.rend()));
+    }
+}
+
+TEST(SplitJoinTestSuite, AvlAndTreapStayBalanced) {
+    std::mt19937 generator(27);
+    std::vector<int32_t> all = SortedKeys(2000, generator);
+    std::vector<int32_t> shuffled = all;
+    std::shuffle(shuffled.begin(), shuffled.end(), generator);
+    auto middle = std::lower_bound(all.begin(), all.end(), 300);
+
+    AvlTree avl;
+    Treap treap;
+    for (int32_t value : shuffled) {
+        avl.insert(value);
+        treap.insert(value);
+    }
+    auto [avl_lower, avl_upper] = avl.split(300);
+    ASSERT_TRUE(IsValidAvlTree(avl_lower));
+    ASSERT_TRUE(IsValidAvlTree(avl_upper));
+    ASSERT_EQ(std::vector<int32_t>(avl_upper.begin(), avl_upper.end()), std::vector<int32_t>(middle, all.end()));
+
+    avl = AvlTree::join(std::move(avl_lower), std::move(avl_upper));
+    ASSERT_TRUE(IsValidAvlTree(avl));
+    ASSERT_EQ(std::vector<int32_t>(avl.begin(), avl.end()), all);
+
+    auto [treap_lower, treap_upper] = treap.split(300);
+    ASSERT_TRUE(IsValidTreap(treap_lower));
+    ASSERT_TRUE(IsValidTreap(treap_upper));
+    ASSERT_EQ(std::vector<int32_t>(treap_lower.begin(), treap_lower.end()), std::vector<int32_t>(all.begin(), middle));
+
+    treap = Treap::join(std::move(treap_lower), std::move(treap_upper));
+    ASSERT_TRUE(IsValidTreap(treap));
+    ASSERT_EQ(std::vector<int32_t>(treap.begin(), treap.end()), all);
+}
+
+TEST(SplitJoinTestSuite, SubtreeSizesAndUnbalancedPolicies) {
+    std::mt19937 generator(28);
+    std::vector<int32_t> all = SortedKeys(2000, generator);
+    auto middle = std::lower_bound(all.begin(), all.end(), 700);
+    size_t lower_size = static_cast<size_t>(middle - all.begin());
+
+    OrderStatisticTree ranked(all.begin(), all.end());
+    auto [lower, upper] = ranked.split(700);
+    ASSERT_TRUE(IsValidOrderStatisticTree(lower));
+    ASSERT_TRUE(IsValidOrderStatisticTree(upper));
+    ASSERT_EQ(lower.size(), lower_size);
+    ASSERT_EQ(*upper.nth_element(0), *middle);
+
+    ranked = OrderStatisticTree::join(std::move(lower), std::move(upper));
+    ASSERT_TRUE(IsValidOrderStatisticTree(ranked));
+    ASSERT_EQ(*ranked.nth_element(lower_size), *middle);
+
+    std::vector<int32_t> shuffled = all;
+    std::shuffle(shuffled.begin(), shuffled.end(), generator);
+    BinarySearchTree<int32_t> plain;
+    for (int32_t value : shuffled) {
+        plain.insert(value);
+    }
+    auto [plain_lower, plain_upper] = plain.split(700);
+    ASSERT_EQ(plain_lower.size(), lower_size);
+    plain = BinarySearchTree<int32_t>::join(std::move(plain_lower), std::move(plain_upper));
+    ASSERT_EQ(std::vector<int32_t>(plain.begin(), plain.end()), all);
+
+    SplayTree splay(all.begin(), all.end());
+    auto [splay_lower, splay_upper] = splay.split(700);
+    ASSERT_EQ(splay_upper.size(), all.size() - lower_size);
+    splay = SplayTree::join(std::move(splay_lower), std::move(splay_upper));
+    ASSERT_EQ(std::vector<int32_t>(splay.begin(), splay.end()), all);
+}
+
+TEST(SplitJoinTestSuite, OverlappingJoinFallsBackToMerge) {
+    RedBlackTree lhs;
+    RedBlackTree rhs;
+    for (int32_t i = 0; i < 100; ++i) {
+        lhs.insert(i * 2);
+        rhs.insert(i * 2 + 1);
+    }
+
+    RedBlackTree joined = RedBlackTree::join(std::move(lhs), std::move(rhs));
+    std::vector<int32_t> expected(200);
+    std::iota(expected.begin(), expected.end(), 0);
+
+    ASSERT_EQ(std::vector<int32_t>(joined.begin(), joined.end()), expected);
+    ASSERT_TRUE(IsValidRedBlackTree(joined));
+    ASSERT_TRUE(rhs.empty());
+
+    RedBlackTree empty;
+    RedBlackTree single = RedBlackTree::join(std::move(empty), RedBlackTree(expected.begin(), expected.begin() + 1));
+    ASSERT_EQ(single.size(), 1);
+    ASSERT_EQ(single.front(), 0);
+
+    RedBlackTree moved = std::move(joined);
+    ASSERT_TRUE(joined.empty());
+    ASSERT_EQ(moved.size(), 200);
+
+    joined = std::move(moved);
+    ASSERT_TRUE(moved.empty());
+    ASSERT_TRUE(IsValidRedBlackTree(joined));
+    ASSERT_EQ(joined.back(), 199);
+    static_assert(std::is_nothrow_move_assignable_v<RedBlackTree>);
+
+    auto root = joined.begin(pre).Get();
+    RedBlackTree accumulator = RedBlackTree::join(RedBlackTree(), std::move(joined));
+    ASSERT_TRUE(joined.empty());
+    ASSERT_EQ(accumulator.begin(pre).Get(), root);
+    ASSERT_EQ(accumulator.size(), 200);
+}
+
+TEST(RangeEraseTestSuite, EraseRangeByKey) {
+    std::mt19937 generator(29);
+    std::vector<int32_t> keys = SortedKeys(2000, generator);
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    for (auto [lo, hi] : std::vector<std::pair<int32_t, int32_t>>{{-5, 0}, {0, 1000}, {100, 101}, {250, 750},
+                                                                   {0, 500}, {500, 2000}, {600, 400}}) {
+        RedBlackTree tree;
+        for (int32_t key : keys) {
+            tree.insert(key);
+        }
+        std::vector<int32_t> expected(tree.begin(), tree.end());
+        std::erase_if(expected, [lo, hi](int32_t value) { return lo <= value && value < hi; });
+
+        ASSERT_EQ(tree.erase_range(lo, hi), keys.size() - expected.size());
+        ASSERT_TRUE(IsValidRedBlackTree(tree));
+        ASSERT_EQ(tree.size(), expected.size());
+        ASSERT_EQ(std::vector<int32_t>(tree.begin(), tree.end()), expected);
+        ASSERT_EQ(std::vector<int32_t>(tree.rbegin(), tree.rend()), std::vector<int32_t>(expected.rbegin(), expected.rend()));
+    }
+}
+
+TEST(RangeEraseTestSuite, EraseRangeKeepsPoliciesAndSubtreeSizes) {
+    std::mt19937 generator(30);
+    std::vector<int32_t> keys = SortedKeys(2000, generator);
+    std::vector<int32_t> expected = keys;
+    std::erase_if(expected, [](int32_t value) { return 250 <= value && value < 750; });
+    std::shuffle(keys.begin(), keys.end(), generator);
+
+    AvlTree avl;
+    Treap treap;
+    OrderStatisticTree ranked;
+    BinarySearchTree<int32_t> plain;
+    SplayTree splay;
+    for (int32_t key : keys) {
+        avl.insert(key);
+        treap.insert(key);
+        ranked.insert(key);
+        plain.insert(key);
+        splay.insert(key);
+    }
+
+    size_t erased = keys.size() - expected.size();
+    ASSERT_EQ(avl.erase_range(250, 750), erased);
+    ASSERT_EQ(treap.erase_range(250, 750), erased);
+    ASSERT_EQ(ranked.erase_range(250, 750), erased);
+    ASSERT_EQ(plain.erase_range(250, 750), erased);
+    ASSERT_EQ(splay.erase_range(250, 750), erased);
+
+    ASSERT_TRUE(IsValidAvlTree(avl));
+    ASSERT_TRUE(IsValidTreap(treap));
+    ASSERT_TRUE(IsValidOrderStatisticTree(ranked));
+    ASSERT_EQ(*ranked.nth_element(expected.size() / 2), expected[expected.size() / 2]);
+    ASSERT_EQ(std::vector<int32_t>(avl.begin(), avl.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(treap.begin(), treap.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(plain.begin(), plain.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(splay.begin(), splay.end()), expected);
+}
+
+TEST(RangeEraseTestSuite, EraseIfRelinksSurvivors) {
+    std::mt19937 generator(31);
+    std::vector<int32_t> keys = SortedKeys(2000, generator);
+
+    for (int32_t divisor : {1, 3, 1000}) {
+        RedBlackTree tree(keys.begin(), keys.end());
+        std::vector<int32_t> expected = keys;
+        auto pred = [divisor](int32_t value) { return value % divisor == 0; };
+        size_t erased = std::erase_if(expected, pred);
+
+        ASSERT_EQ(tree.erase_if(pred), erased);
+        ASSERT_TRUE(IsValidRedBlackTree(tree));
+        ASSERT_EQ(tree.size(), expected.size());
+        ASSERT_EQ(std::vector<int32_t>(tree.begin(), tree.end()), expected);
+
+        tree.insert(divisor);
+        ASSERT_TRUE(IsValidRedBlackTree(tree));
+        ASSERT_TRUE(tree.contains(divisor));
+    }
+
+    auto odd = [](int32_t value) { return value % 2 != 0; };
+    std::vector<int32_t> expected = keys;
+    size_t erased = std::erase_if(expected, odd);
+
+    OrderStatisticTree ranked(keys.begin(), keys.end());
+    ASSERT_EQ(ranked.erase_if(odd), erased);
+    ASSERT_TRUE(IsValidOrderStatisticTree(ranked));
+    ranked.insert(1);
+    ASSERT_TRUE(IsValidOrderStatisticTree(ranked));
+
+    AvlTree avl(keys.begin(), keys.end());
+    Treap treap(keys.begin(), keys.end());
+    SplayTree splay(keys.begin(), keys.end());
+    ASSERT_EQ(avl.erase_if(odd), erased);
+    ASSERT_EQ(treap.erase_if(odd), erased);
+    ASSERT_EQ(splay.erase_if(odd), erased);
+    ASSERT_TRUE(IsValidAvlTree(avl));
+    ASSERT_TRUE(IsValidTreap(treap));
+    ASSERT_EQ(std::vector<int32_t>(avl.begin(), avl.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(treap.begin(), treap.end()), expected);
+    ASSERT_EQ(std::vector<int32_t>(splay.begin(), splay.end()), expected);
+}
+
+TEST(RangeEraseTestSuite, IteratorRangeKeepsNodesOutsideIt) {
+    RedBlackTree tree;
+    for (int32_t i = 0; i < 10; ++i) {
+        tree.insert(i);
+        tree.insert(i);
+    }
+
+    auto first = std::next(tree.begin(), 5);
+    auto last = std::next(tree.begin(), 13);
+    auto kept = last.Get();
+    auto next = tree.erase(first, last);
+
+    ASSERT_EQ(next.Get(), kept);
+    ASSERT_EQ(*next, 6);
+    ASSERT_EQ(tree.size(), 12);
+    ASSERT_EQ(std::vector<int32_t>(tree.begin(), tree.end()),
+              std::vector<int32_t>({0, 0, 1, 1, 2, 6, 7, 7, 8, 8, 9, 9}));
+    ASSERT_TRUE(IsValidRedBlackTree(tree));
+
+    ASSERT_EQ(tree.erase(tree.begin(), tree.begin()), tree.begin());
+    ASSERT_EQ(tree.erase(std::next(tree.begin(), 8), tree.end()), tree.end());
+    ASSERT_EQ(tree.back(), 7);
+    ASSERT_EQ(tree.erase(tree.begin(), tree.end()), tree.end());
+    ASSERT_TRUE(tree.empty());
+    ASSERT_EQ(tree.erase_if([](int32_t) { return true; }), 0);
+}